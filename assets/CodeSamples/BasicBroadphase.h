@@ -0,0 +1,239 @@
+﻿#pragma once
+/*******************************************************************************
+
+	@file BasicBroadphase.h
+
+	@date 10/17/2026 9:41:18 PM
+
+	@authors
+	Christian Wookey (christian.wookey@digipen.edu)
+
+	@brief
+	Picks a quadtree or spatial hash grid for a scene and hides which one it picked.
+
+	@copyright All content © copyright 2020-2021, DigiPen (USA) Corporation 
+
+*******************************************************************************/
+
+#include "BasicQuadtree.h"
+#include "BasicSpatialHashGrid.h"
+#include <variant>
+#include <span>
+
+/// <summary>
+/// How the objects of a scene are spread out. Used to choose a broadphase.
+/// </summary>
+struct SceneDensity
+{
+	/// <summary>
+	/// The number of objects measured.
+	/// </summary>
+	unsigned objectCount = 0;
+
+	/// <summary>
+	/// The smallest AABB that holds every object.
+	/// </summary>
+	AABB extent;
+
+	/// <summary>
+	/// The median of the larger side of each object's AABB.
+	/// </summary>
+	float medianSize = 0.f;
+
+	/// <summary>
+	/// The 90th percentile of the larger side of each object's AABB.
+	/// </summary>
+	float largeSize = 0.f;
+
+	/// <summary>
+	/// How unevenly the objects are spread: the coefficient of variation of the number of object
+	/// centers in each bin of a coarse grid with about 4 objects per bin. About 0.5 for objects
+	/// spread at random, and well above 1 when they are clustered.
+	/// </summary>
+	float clustering = 0.f;
+};
+
+/// <summary>
+/// The broadphases BasicBroadphase can use.
+/// </summary>
+enum class BroadphaseBackend
+{
+	Quadtree,
+	SpatialHashGrid
+};
+
+/// <summary>
+/// Measures how the objects of a scene are spread out.
+/// </summary>
+/// <param name="bounds">The AABB of every object.</param>
+/// <returns>The density statistics.</returns>
+SceneDensity MeasureDensity(std::span<const AABB> bounds);
+
+/// <summary>
+/// Picks the broadphase that should be fastest for a scene. A spatial hash grid is picked when
+/// there are enough objects, their sizes are similar and they are spread fairly evenly, and
+/// a quadtree otherwise.
+/// </summary>
+/// <param name="density">The statistics of the scene.</param>
+/// <returns>The broadphase to use.</returns>
+BroadphaseBackend ChooseBackend(const SceneDensity& density) noexcept;
+
+/// <summary>
+/// Picks the cell size of a spatial hash grid for a scene: twice the median object size, so most
+/// objects touch at most 4 cells.
+/// </summary>
+/// <param name="density">The statistics of the scene.</param>
+/// <returns>The cell size. Always greater than 0.</returns>
+float SuggestCellSize(const SceneDensity& density) noexcept;
+
+/// <summary>
+/// A broadphase that is either a BasicQuadtree or a BasicSpatialHashGrid, behind the surface both
+/// share. Choose() measures a scene and builds whichever suits it, so game code can switch backend
+/// per scene without changing.
+/// T and BoundsFn work the same way as in BasicQuadtree. Broadphase is the version that stores GameObject pointers.
+/// </summary>
+template<typename T, typename BoundsFn>
+class BasicBroadphase
+{
+public:
+
+	/// <summary>
+	/// Two objects whose AABBs overlap.
+	/// </summary>
+	using ObjectPair = std::pair<T, T>;
+
+	/// <summary>
+	/// The quadtree backend.
+	/// </summary>
+	using Tree = BasicQuadtree<T, BoundsFn>;
+
+	/// <summary>
+	/// The spatial hash grid backend.
+	/// </summary>
+	using Grid = BasicSpatialHashGrid<T, BoundsFn>;
+
+	/// <summary>
+	/// Default constructor.
+	/// </summary>
+	/// <returns>A new BasicBroadphase that uses a quadtree with the default settings</returns>
+	BasicBroadphase() : BasicBroadphase(Tree()) {}
+
+	/// <summary>
+	/// Non-default constructor.
+	/// </summary>
+	/// <param name="tree">The quadtree to use.</param>
+	/// <returns>A new BasicBroadphase that uses the quadtree.</returns>
+	BasicBroadphase(Tree tree);
+
+	/// <summary>
+	/// Non-default constructor.
+	/// </summary>
+	/// <param name="grid">The spatial hash grid to use.</param>
+	/// <returns>A new BasicBroadphase that uses the grid.</returns>
+	BasicBroadphase(Grid grid);
+
+	/// <summary>
+	/// Measures a scene, picks a backend for it with ChooseBackend() and adds every object.
+	/// </summary>
+	/// <param name="objects">The objects of the scene. Every object must be unique.</param>
+	/// <param name="boundsFn">Reads the AABB of an item.</param>
+	/// <returns>A new BasicBroadphase holding the objects.</returns>
+	static BasicBroadphase Choose(std::span<const T> objects, BoundsFn boundsFn = BoundsFn());
+
+	/// <summary>
+	/// Gets which backend is in use.
+	/// </summary>
+	/// <returns>The backend.</returns>
+	BroadphaseBackend GetBackend() const noexcept;
+
+	/// <summary>
+	/// Gets the quadtree, for settings only it has.
+	/// </summary>
+	/// <returns>The quadtree, or nullptr if a grid is in use.</returns>
+	Tree* GetTree() noexcept;
+
+	/// <summary>
+	/// Gets the spatial hash grid, for settings only it has.
+	/// </summary>
+	/// <returns>The grid, or nullptr if a quadtree is in use.</returns>
+	Grid* GetGrid() noexcept;
+
+	/// <summary>
+	/// Adds an object.
+	/// </summary>
+	/// <param name="object">The object to add.</param>
+	/// <returns>true if the object was inserted successfully, false otherwise.</returns>
+	bool Insert(T object);
+
+	/// <summary>
+	/// Removes an object.
+	/// </summary>
+	/// <param name="object">The object to remove.</param>
+	/// <returns>true if the object was found and removed, false otherwise.</returns>
+	bool Remove(T object);
+
+	/// <summary>
+	/// Moves an object to match its current AABB.
+	/// </summary>
+	/// <param name="object">The object that moved.</param>
+	/// <returns>true if the object was found.</returns>
+	bool Update(T object);
+
+	/// <summary>
+	/// Removes every object.
+	/// </summary>
+	void Clear();
+
+	/// <summary>
+	/// Given an object, find all the objects that overlap its AABB.
+	/// </summary>
+	/// <param name="object">The object to check</param>
+	/// <param name="collisionCandidates">A reference to a vector of T</param>
+	void GetCollisionCandidates(T object, _Inout_ std::vector<T>& collisionCandidates) const;
+
+	/// <summary>
+	/// Given an object, calls a visitor with each object that overlaps its AABB.
+	/// </summary>
+	/// <param name="object">The object to check</param>
+	/// <param name="visitor">Called as visitor(T) for each candidate. May return false to stop.</param>
+	/// <returns>false if the visitor stopped early.</returns>
+	template<typename Visitor> requires std::invocable<Visitor&, T>
+	bool GetCollisionCandidates(T object, Visitor&& visitor) const;
+
+	/// <summary>
+	/// Finds every object whose AABB overlaps an area.
+	/// </summary>
+	/// <param name="area">The area to search.</param>
+	/// <param name="results">The vector the objects are added to.</param>
+	void QueryRegion(const AABB& area, _Inout_ std::vector<T>& results) const;
+
+	/// <summary>
+	/// Calls a visitor with every object whose AABB overlaps an area.
+	/// </summary>
+	/// <param name="area">The area to search.</param>
+	/// <param name="visitor">Called as visitor(T) for each object. May return false to stop.</param>
+	/// <returns>false if the visitor stopped early.</returns>
+	template<typename Visitor> requires std::invocable<Visitor&, T>
+	bool QueryRegion(const AABB& area, Visitor&& visitor) const;
+
+	/// <summary>
+	/// Finds every pair of objects whose AABBs overlap, each pair exactly once.
+	/// </summary>
+	/// <param name="pairs">The vector the overlapping pairs are appended to.</param>
+	void FindAllPairs(_Inout_ std::vector<ObjectPair>& pairs);
+
+	/// <summary>
+	/// Counts the total number objects.
+	/// </summary>
+	/// <returns>the total number objects</returns>
+	unsigned GetTotalObjects() const noexcept;
+
+private:
+
+	/// <summary>
+	/// The backend in use.
+	/// </summary>
+	std::variant<Tree, Grid> backend_;
+};
+
+#include "BasicBroadphase.inl"
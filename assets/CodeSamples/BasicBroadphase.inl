@@ -0,0 +1,138 @@
+﻿#pragma once
+/*******************************************************************************
+
+	@file BasicBroadphase.inl
+
+	@date 10/17/2026 9:41:18 PM
+
+	@authors
+	Christian Wookey (christian.wookey@digipen.edu)
+
+	@brief
+	Picks a quadtree or spatial hash grid for a scene and hides which one it picked.
+
+	@copyright All content © copyright 2020-2021, DigiPen (USA) Corporation 
+
+*******************************************************************************/
+
+/*****************************************************************************/
+/*                             PUBLIC FUNCTIONS                              */
+/*****************************************************************************/
+template<typename T, typename BoundsFn>
+BasicBroadphase<T, BoundsFn>::BasicBroadphase(Tree tree) : backend_(std::in_place_type<Tree>, std::move(tree))
+{
+}
+
+template<typename T, typename BoundsFn>
+BasicBroadphase<T, BoundsFn>::BasicBroadphase(Grid grid) : backend_(std::in_place_type<Grid>, std::move(grid))
+{
+}
+
+template<typename T, typename BoundsFn>
+BasicBroadphase<T, BoundsFn> BasicBroadphase<T, BoundsFn>::Choose(std::span<const T> objects, BoundsFn boundsFn)
+{
+	std::vector<AABB> bounds;
+	bounds.reserve(objects.size());
+	for (const T& object : objects)
+	{
+		bounds.push_back(boundsFn(object));
+	}
+
+	const SceneDensity density = MeasureDensity(bounds);
+	if (ChooseBackend(density) == BroadphaseBackend::SpatialHashGrid)
+	{
+		BasicBroadphase broadphase(Grid(SuggestCellSize(density), std::move(boundsFn)));
+		for (const T& object : objects)
+		{
+			broadphase.Insert(object);
+		}
+		return broadphase;
+	}
+
+	BasicBroadphase broadphase(Tree(6, 8, density.objectCount ? density.extent : AABB(-10.f, -10.f, 10.f, 10.f), std::move(boundsFn)));
+	broadphase.GetTree()->BuildFrom(objects);
+	return broadphase;
+}
+
+template<typename T, typename BoundsFn>
+BroadphaseBackend BasicBroadphase<T, BoundsFn>::GetBackend() const noexcept
+{
+	return std::holds_alternative<Tree>(backend_) ? BroadphaseBackend::Quadtree : BroadphaseBackend::SpatialHashGrid;
+}
+
+template<typename T, typename BoundsFn>
+typename BasicBroadphase<T, BoundsFn>::Tree* BasicBroadphase<T, BoundsFn>::GetTree() noexcept
+{
+	return std::get_if<Tree>(&backend_);
+}
+
+template<typename T, typename BoundsFn>
+typename BasicBroadphase<T, BoundsFn>::Grid* BasicBroadphase<T, BoundsFn>::GetGrid() noexcept
+{
+	return std::get_if<Grid>(&backend_);
+}
+
+template<typename T, typename BoundsFn>
+bool BasicBroadphase<T, BoundsFn>::Insert(T object)
+{
+	return std::visit([&](auto& backend) { return backend.Insert(object); }, backend_);
+}
+
+template<typename T, typename BoundsFn>
+bool BasicBroadphase<T, BoundsFn>::Remove(T object)
+{
+	return std::visit([&](auto& backend) { return backend.Remove(object); }, backend_);
+}
+
+template<typename T, typename BoundsFn>
+bool BasicBroadphase<T, BoundsFn>::Update(T object)
+{
+	return std::visit([&](auto& backend) { return backend.Update(object); }, backend_);
+}
+
+template<typename T, typename BoundsFn>
+void BasicBroadphase<T, BoundsFn>::Clear()
+{
+	std::visit([](auto& backend) { backend.Clear(); }, backend_);
+}
+
+template<typename T, typename BoundsFn>
+void BasicBroadphase<T, BoundsFn>::GetCollisionCandidates(T object, _Inout_ std::vector<T>& collisionCandidates) const
+{
+	std::visit([&](const auto& backend) { backend.GetCollisionCandidates(object, collisionCandidates); }, backend_);
+}
+
+template<typename T, typename BoundsFn>
+void BasicBroadphase<T, BoundsFn>::QueryRegion(const AABB& area, _Inout_ std::vector<T>& results) const
+{
+	std::visit([&](const auto& backend) { backend.QueryRegion(area, results); }, backend_);
+}
+
+template<typename T, typename BoundsFn>
+void BasicBroadphase<T, BoundsFn>::FindAllPairs(_Inout_ std::vector<ObjectPair>& pairs)
+{
+	std::visit([&](auto& backend) { backend.FindAllPairs(pairs); }, backend_);
+}
+
+template<typename T, typename BoundsFn>
+unsigned BasicBroadphase<T, BoundsFn>::GetTotalObjects() const noexcept
+{
+	return std::visit([](const auto& backend) { return backend.GetTotalObjects(); }, backend_);
+}
+
+/*****************************************************************************/
+/*                            TEMPLATE FUNCTIONS                             */
+/*****************************************************************************/
+template<typename T, typename BoundsFn>
+template<typename Visitor> requires std::invocable<Visitor&, T>
+bool BasicBroadphase<T, BoundsFn>::GetCollisionCandidates(T object, Visitor&& visitor) const
+{
+	return std::visit([&](const auto& backend) { return backend.GetCollisionCandidates(object, visitor); }, backend_);
+}
+
+template<typename T, typename BoundsFn>
+template<typename Visitor> requires std::invocable<Visitor&, T>
+bool BasicBroadphase<T, BoundsFn>::QueryRegion(const AABB& area, Visitor&& visitor) const
+{
+	return std::visit([&](const auto& backend) { return backend.QueryRegion(area, visitor); }, backend_);
+}
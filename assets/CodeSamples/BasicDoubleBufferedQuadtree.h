@@ -0,0 +1,187 @@
+﻿#pragma once
+/*******************************************************************************
+
+	@file BasicDoubleBufferedQuadtree.h
+
+	@date 10/17/2026 8:12:40 PM
+
+	@authors
+	Christian Wookey (christian.wookey@digipen.edu)
+
+	@brief
+	Two quadtrees, one read by this frame while the next frame's is built.
+
+	@copyright All content © copyright 2020-2021, DigiPen (USA) Corporation 
+
+*******************************************************************************/
+
+#include "BasicQuadtree.h"
+
+/// <summary>
+/// Holds two BasicQuadtrees so building next frame's tree can overlap queries on this frame's.
+/// The front tree is frozen and may be read by any number of threads through a ReadHandle.
+/// One builder thread changes the back tree and then publishes it, which makes it the front
+/// in a single atomic store. Readers that already hold the old front keep reading it, and the
+/// builder waits for them to let go before it touches that tree again.
+/// T and BoundsFn work the same way as in BasicQuadtree. DoubleBufferedQuadtree is the version that stores GameObject pointers.
+/// </summary>
+template<typename T, typename BoundsFn>
+class BasicDoubleBufferedQuadtree
+{
+public:
+
+	/// <summary>
+	/// The type of the two trees.
+	/// </summary>
+	using Tree = BasicQuadtree<T, BoundsFn>;
+
+	/// <summary>
+	/// Keeps one published tree alive for reading. The builder will not reuse the tree until
+	/// every handle to it is destroyed, so hold a handle for a frame at most.
+	/// </summary>
+	class ReadHandle
+	{
+	public:
+
+		/// destructor
+		~ReadHandle();
+
+		/// delete copy constructor
+		ReadHandle(const ReadHandle&) = delete;
+		/// delete copy assignment operator
+		ReadHandle& operator=(const ReadHandle&) = delete;
+
+		/// <summary>
+		/// Move constructor. The other handle no longer holds the tree.
+		/// </summary>
+		ReadHandle(ReadHandle&& other) noexcept;
+
+		/// delete move assignment operator
+		ReadHandle& operator=(ReadHandle&&) = delete;
+
+		/// <summary>
+		/// Gets the tree being read.
+		/// </summary>
+		/// <returns>The frozen tree that was the front when the handle was acquired.</returns>
+		const Tree& operator*() const noexcept;
+
+		/// <summary>
+		/// Gets the tree being read.
+		/// </summary>
+		/// <returns>The frozen tree that was the front when the handle was acquired.</returns>
+		const Tree* operator->() const noexcept;
+
+	private:
+
+		friend class BasicDoubleBufferedQuadtree;
+
+		/// <summary>
+		/// Constructor used by Acquire. The reader count of the tree must already be incremented.
+		/// </summary>
+		ReadHandle(const BasicDoubleBufferedQuadtree* owner, unsigned index) noexcept;
+
+		/// <summary>
+		/// The trees the handle reads from, null after being moved from.
+		/// </summary>
+		const BasicDoubleBufferedQuadtree* owner_;
+
+		/// <summary>
+		/// Which of the two trees is held.
+		/// </summary>
+		unsigned index_;
+	};
+
+	/// <summary>
+	/// Default constructor.
+	/// </summary>
+	/// <returns>A new BasicDoubleBufferedQuadtree with the default settings</returns>
+	BasicDoubleBufferedQuadtree() : BasicDoubleBufferedQuadtree(AABB(-10.f, -10.f, 10.f, 10.f)) {}
+
+	/// <summary>
+	/// Non-default constructor.
+	/// </summary>
+	/// <param name="bounds">The area that the trees cover.</param>
+	/// <returns>A new BasicDoubleBufferedQuadtree with the specified bounds</returns>
+	BasicDoubleBufferedQuadtree(AABB bounds) : BasicDoubleBufferedQuadtree(6, 8, bounds) {}
+
+	/// <summary>
+	/// Non-default constructor. Both trees start empty and the front is already published.
+	/// </summary>
+	/// <param name="maxDepth">Maximum depth of both trees.</param>
+	/// <param name="maxObjects">The maximum number of objects stored in one node.</param>
+	/// <param name="bounds">The area that the trees cover.</param>
+	/// <param name="boundsFn">Reads the AABB of an item.</param>
+	/// <returns>A new BasicDoubleBufferedQuadtree with a specified bounds, max depth and max objects.</returns>
+	BasicDoubleBufferedQuadtree(unsigned maxDepth, unsigned maxObjects, AABB bounds, BoundsFn boundsFn = BoundsFn());
+
+	/// destructor
+	~BasicDoubleBufferedQuadtree() = default;
+
+	/// delete copy constructor
+	BasicDoubleBufferedQuadtree(const BasicDoubleBufferedQuadtree&) = delete;
+	/// delete copy assignment operator
+	BasicDoubleBufferedQuadtree& operator=(const BasicDoubleBufferedQuadtree&) = delete;
+	/// delete move constructor
+	BasicDoubleBufferedQuadtree(BasicDoubleBufferedQuadtree&&) = delete;
+	/// delete move assignment operator
+	BasicDoubleBufferedQuadtree& operator=(BasicDoubleBufferedQuadtree&&) = delete;
+
+	/// <summary>
+	/// Starts reading the front tree. Safe to call from any thread at any time.
+	/// </summary>
+	/// <returns>A handle that keeps the current front tree from being reused until it is destroyed.</returns>
+	ReadHandle Acquire() const noexcept;
+
+	/// <summary>
+	/// Gets the back tree so it can be changed. Waits until no reader holds it, then thaws it.
+	/// Only the builder thread may call this.
+	/// </summary>
+	/// <returns>The back tree, which holds what was published two frames ago.</returns>
+	Tree& BeginBuild() noexcept;
+
+	/// <summary>
+	/// Freezes the back tree and makes it the front. Readers that acquire after this see it.
+	/// Only the builder thread may call this.
+	/// </summary>
+	void Publish() noexcept;
+
+	/// <summary>
+	/// Replaces the back tree with one built somewhere else and publishes it. The tree is moved
+	/// in without copying its nodes, and is left holding the old back tree.
+	/// Only the builder thread may call this.
+	/// </summary>
+	/// <param name="tree">The tree to publish.</param>
+	void Publish(Tree&& tree) noexcept;
+
+	/// <summary>
+	/// Gets the front tree without holding it. Only safe on the builder thread, where nothing can
+	/// replace the front, for example to copy objects from it into the back tree.
+	/// </summary>
+	/// <returns>The last published tree.</returns>
+	const Tree& GetFront() const noexcept;
+
+private:
+
+	/// <summary>
+	/// Waits until no reader holds a tree.
+	/// </summary>
+	/// <param name="index">Which of the two trees to wait for.</param>
+	void WaitForReaders(unsigned index) const noexcept;
+
+	/// <summary>
+	/// The two trees. trees_[front_] is published, the other is being built.
+	/// </summary>
+	std::array<Tree, 2> trees_;
+
+	/// <summary>
+	/// Which tree readers should acquire. Only written by the builder thread.
+	/// </summary>
+	std::atomic<unsigned> front_;
+
+	/// <summary>
+	/// How many handles hold each tree.
+	/// </summary>
+	mutable std::array<std::atomic<unsigned>, 2> readers_;
+};
+
+#include "BasicDoubleBufferedQuadtree.inl"
@@ -0,0 +1,116 @@
+﻿#pragma once
+/*******************************************************************************
+
+	@file BasicDoubleBufferedQuadtree.inl
+
+	@date 10/17/2026 8:12:40 PM
+
+	@authors
+	Christian Wookey (christian.wookey@digipen.edu)
+
+	@brief
+	Two quadtrees, one read by this frame while the next frame's is built.
+
+	@copyright All content © copyright 2020-2021, DigiPen (USA) Corporation 
+
+*******************************************************************************/
+
+/*****************************************************************************/
+/*                             PUBLIC FUNCTIONS                              */
+/*****************************************************************************/
+template<typename T, typename BoundsFn>
+BasicDoubleBufferedQuadtree<T, BoundsFn>::BasicDoubleBufferedQuadtree(unsigned maxDepth, unsigned maxObjects, AABB bounds, BoundsFn boundsFn) : trees_{ Tree(maxDepth, maxObjects, bounds, boundsFn), Tree(maxDepth, maxObjects, bounds, boundsFn) }, front_(0), readers_{}
+{
+	trees_[0].Freeze();
+}
+
+template<typename T, typename BoundsFn>
+typename BasicDoubleBufferedQuadtree<T, BoundsFn>::ReadHandle BasicDoubleBufferedQuadtree<T, BoundsFn>::Acquire() const noexcept
+{
+	for (;;)
+	{
+		unsigned index = front_.load();
+		readers_[index].fetch_add(1);
+
+		// the builder may have published and started waiting on this tree between the two lines above
+		if (front_.load() == index)
+			return ReadHandle(this, index);
+
+		readers_[index].fetch_sub(1);
+	}
+}
+
+template<typename T, typename BoundsFn>
+typename BasicDoubleBufferedQuadtree<T, BoundsFn>::Tree& BasicDoubleBufferedQuadtree<T, BoundsFn>::BeginBuild() noexcept
+{
+	unsigned back = 1 - front_.load();
+	WaitForReaders(back);
+
+	trees_[back].Thaw();
+	return trees_[back];
+}
+
+template<typename T, typename BoundsFn>
+void BasicDoubleBufferedQuadtree<T, BoundsFn>::Publish() noexcept
+{
+	unsigned back = 1 - front_.load();
+
+	trees_[back].Freeze();
+	front_.store(back);
+}
+
+template<typename T, typename BoundsFn>
+void BasicDoubleBufferedQuadtree<T, BoundsFn>::Publish(Tree&& tree) noexcept
+{
+	unsigned back = 1 - front_.load();
+	WaitForReaders(back);
+
+	trees_[back].Swap(tree);
+	Publish();
+}
+
+template<typename T, typename BoundsFn>
+const typename BasicDoubleBufferedQuadtree<T, BoundsFn>::Tree& BasicDoubleBufferedQuadtree<T, BoundsFn>::GetFront() const noexcept
+{
+	return trees_[front_.load()];
+}
+
+template<typename T, typename BoundsFn>
+BasicDoubleBufferedQuadtree<T, BoundsFn>::ReadHandle::~ReadHandle()
+{
+	if (owner_)
+		owner_->readers_[index_].fetch_sub(1);
+}
+
+template<typename T, typename BoundsFn>
+BasicDoubleBufferedQuadtree<T, BoundsFn>::ReadHandle::ReadHandle(ReadHandle&& other) noexcept : owner_(other.owner_), index_(other.index_)
+{
+	other.owner_ = nullptr;
+}
+
+template<typename T, typename BoundsFn>
+const typename BasicDoubleBufferedQuadtree<T, BoundsFn>::Tree& BasicDoubleBufferedQuadtree<T, BoundsFn>::ReadHandle::operator*() const noexcept
+{
+	return owner_->trees_[index_];
+}
+
+template<typename T, typename BoundsFn>
+const typename BasicDoubleBufferedQuadtree<T, BoundsFn>::Tree* BasicDoubleBufferedQuadtree<T, BoundsFn>::ReadHandle::operator->() const noexcept
+{
+	return &owner_->trees_[index_];
+}
+
+/*****************************************************************************/
+/*                             PRIVATE FUNCTIONS                             */
+/*****************************************************************************/
+template<typename T, typename BoundsFn>
+BasicDoubleBufferedQuadtree<T, BoundsFn>::ReadHandle::ReadHandle(const BasicDoubleBufferedQuadtree* owner, unsigned index) noexcept : owner_(owner), index_(index)
+{
+}
+
+template<typename T, typename BoundsFn>
+void BasicDoubleBufferedQuadtree<T, BoundsFn>::WaitForReaders(unsigned index) const noexcept
+{
+	while (readers_[index].load() != 0)
+		std::this_thread::yield();
+}
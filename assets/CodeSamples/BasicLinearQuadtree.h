@@ -0,0 +1,302 @@
+﻿#pragma once
+/*******************************************************************************
+
+	@file BasicLinearQuadtree.h
+
+	@date 10/17/2026 4:12:37 PM
+
+	@authors
+	Christian Wookey (christian.wookey@digipen.edu)
+
+	@brief
+	Pointerless quadtree that is rebuilt from scratch by sorting Morton codes.
+
+	@copyright All content © copyright 2020-2021, DigiPen (USA) Corporation 
+
+*******************************************************************************/
+
+#include "AABB.h"
+#include "OverlapKernel.h"
+#include <vector>
+#include <span>
+#include <utility>
+#include <cstdint>
+#include <unordered_map>
+#include <algorithm>
+#include <bit>
+#include <array>
+#include <numeric>
+#include <execution>
+#include <concepts>
+#include <type_traits>
+
+/// <summary>
+/// A linear quadtree. Instead of allocating nodes, every object is given the Morton (Z-order) key
+/// of the smallest cell that holds its AABB, and the objects are radix sorted by key. Every
+/// subtree is then a contiguous range of the sorted array, so there is nothing to allocate per node
+/// and a rebuild is a handful of linear passes.
+/// Suited to scenes that are rebuilt every frame. Use Quadtree for scenes that change incrementally.
+/// T and BoundsFn work the same way as in BasicQuadtree. LinearQuadtree is the version that stores GameObject pointers.
+/// </summary>
+template<typename T, typename BoundsFn>
+class BasicLinearQuadtree
+{
+public:
+
+	/// <summary>
+	/// Two objects whose AABBs overlap.
+	/// </summary>
+	using ObjectPair = std::pair<T, T>;
+
+	/// <summary>
+	/// Default constructor.
+	/// </summary>
+	/// <returns>A new LinearQuadtree with the default settings</returns>
+	BasicLinearQuadtree() noexcept : BasicLinearQuadtree(AABB(-10.f, -10.f, 10.f, 10.f)) {}
+
+	/// <summary>
+	/// Non-default constructor.
+	/// </summary>
+	/// <param name="bounds">The area that the LinearQuadtree covers.</param>
+	/// <returns>A new LinearQuadtree with the specified bounds</returns>
+	BasicLinearQuadtree(AABB bounds) noexcept : BasicLinearQuadtree(10, bounds) {}
+
+	/// <summary>
+	/// Non-default constructor.
+	/// </summary>
+	/// <param name="maxDepth">Maximum depth of the tree. Clamped to MaxSupportedDepth.</param>
+	/// <param name="bounds">The area that the LinearQuadtree covers.</param>
+	/// <param name="boundsFn">Reads the AABB of an item.</param>
+	/// <returns>A new LinearQuadtree with a specified bounds and max depth.</returns>
+	BasicLinearQuadtree(unsigned maxDepth, AABB bounds, BoundsFn boundsFn = BoundsFn()) noexcept;
+
+	/// destructor
+	~BasicLinearQuadtree() = default;
+
+	BasicLinearQuadtree(const BasicLinearQuadtree&) = default;
+	BasicLinearQuadtree& operator=(const BasicLinearQuadtree&) = default;
+	BasicLinearQuadtree(BasicLinearQuadtree&&) noexcept = default;
+	BasicLinearQuadtree& operator=(BasicLinearQuadtree&&) noexcept = default;
+
+	/// <summary>
+	/// The deepest level a key can describe. Cell coordinates are 16 bits per axis.
+	/// </summary>
+	static constexpr unsigned MaxSupportedDepth = 16;
+
+	/// <summary>
+	/// Adds an object to the tree. It can be found by queries after the next Build().
+	/// </summary>
+	/// <param name="object">The object to add.</param>
+	/// <returns>true if the object was added, false if it was already in the tree.</returns>
+	bool Insert(T object);
+
+	/// <summary>
+	/// Removes an object from the tree. Queries stop returning it after the next Build().
+	/// </summary>
+	/// <param name="object">The object to remove.</param>
+	/// <returns>true if the object was found, false otherwise.</returns>
+	bool Remove(T object);
+
+	/// <summary>
+	/// Clears the tree of all objects.
+	/// </summary>
+	void Clear() noexcept;
+
+	/// <summary>
+	/// Sets a new size for the tree. Takes effect on the next Build().
+	/// </summary>
+	/// <param name="newBounds">The new size of the tree.</param>
+	void Resize(const AABB& newBounds) noexcept;
+
+	/// <summary>
+	/// Clears the tree, adds a set of objects and builds it. Every object must be unique.
+	/// </summary>
+	/// <param name="objects">The objects to store in the tree.</param>
+	void BuildFrom(std::span<const T> objects);
+
+	/// <summary>
+	/// Reads the AABB of every object, computes their keys and sorts them.
+	/// Must be called after changing the tree and before querying it.
+	/// </summary>
+	void Build();
+
+	/// <summary>
+	/// Has the tree changed since the last Build()?
+	/// </summary>
+	/// <returns>true if Build() needs to be called before the next query.</returns>
+	bool IsDirty() const noexcept;
+
+	/// <summary>
+	/// Given an object, find all the objects in the tree that overlapped its AABB at the last Build().
+	/// Read only. Safe to call from many threads at once.
+	/// </summary>
+	/// <param name="object">The object to check</param>
+	/// <param name="collisionCandidates">A reference to a vector of T</param>
+	void GetCollisionCandidates(T object, _Inout_ std::vector<T>& collisionCandidates) const noexcept;
+
+	/// <summary>
+	/// Finds every object whose AABB overlapped an area at the last Build().
+	/// </summary>
+	/// <param name="area">The area to search.</param>
+	/// <param name="results">The vector the objects are added to.</param>
+	void QueryRegion(const AABB& area, _Inout_ std::vector<T>& results) const;
+
+	/// <summary>
+	/// Calls a visitor with every object whose AABB overlapped an area at the last Build(), without allocating.
+	/// </summary>
+	/// <param name="area">The area to search.</param>
+	/// <param name="visitor">Called as visitor(T) for each object. May return false to stop the search.</param>
+	/// <returns>false if the visitor stopped the search.</returns>
+	template<typename Visitor> requires std::invocable<Visitor&, T>
+	bool QueryRegion(const AABB& area, Visitor&& visitor) const;
+
+	/// <summary>
+	/// Finds every pair of objects whose AABBs overlapped at the last Build(), each pair exactly once.
+	/// </summary>
+	/// <param name="pairs">The vector the overlapping pairs are appended to.</param>
+	void FindAllPairs(_Inout_ std::vector<ObjectPair>& pairs) const;
+
+	/// <summary>
+	/// Gets the bounds.
+	/// </summary>
+	/// <returns>A constant AABB reference to the bounds of the tree.</returns>
+	const AABB& GetBounds() const noexcept;
+
+	/// <summary>
+	/// Counts the total number objects in the tree.
+	/// </summary>
+	/// <returns>the total number objects in the tree</returns>
+	unsigned GetTotalObjects() const noexcept;
+
+private:
+
+	/// <summary>
+	/// A cell of the implicit tree. The Morton code is left aligned to maxDepth_, so a cell and
+	/// all of its descendants share a contiguous range of codes starting at its own.
+	/// </summary>
+	struct Cell
+	{
+		uint32_t code;
+		unsigned level;
+	};
+
+	/// <summary>
+	/// Finds the smallest cell that holds an AABB.
+	/// </summary>
+	/// <param name="bounds">The AABB to place.</param>
+	/// <returns>The cell.</returns>
+	Cell GetCell(const AABB& bounds) const noexcept;
+
+	/// <summary>
+	/// Builds the sort key of a cell. Sorting by key orders cells by code and then parents before children.
+	/// </summary>
+	/// <param name="cell">The cell.</param>
+	/// <returns>The key.</returns>
+	static uint64_t GetKey(Cell cell) noexcept;
+
+	/// <summary>
+	/// Finds the sorted range of objects stored in a cell or any of its descendants.
+	/// </summary>
+	/// <param name="cell">The cell.</param>
+	/// <returns>The first and one past the last index of the range.</returns>
+	std::pair<unsigned, unsigned> GetSubtreeRange(Cell cell) const noexcept;
+
+	/// <summary>
+	/// Finds the sorted range of objects stored in exactly one cell.
+	/// </summary>
+	/// <param name="cell">The cell.</param>
+	/// <returns>The first and one past the last index of the range.</returns>
+	std::pair<unsigned, unsigned> GetCellRange(Cell cell) const noexcept;
+
+	/// <summary>
+	/// Calls a visitor with the index of every sorted object in a range whose bounds overlap an area.
+	/// </summary>
+	/// <param name="area">The area to test against.</param>
+	/// <param name="range">The range to test.</param>
+	/// <param name="visitor">Called as visitor(unsigned index) for each overlap. May return false to stop.</param>
+	/// <returns>false if the visitor stopped.</returns>
+	template<typename Visitor>
+	bool ForEachOverlap(const AABB& area, std::pair<unsigned, unsigned> range, Visitor&& visitor) const;
+
+	/// <summary>
+	/// Calls a visitor that may or may not return a bool.
+	/// </summary>
+	/// <returns>What the visitor returned, or true if it returns nothing.</returns>
+	template<typename Visitor, typename... Args>
+	static bool Visit(Visitor& visitor, Args&&... args);
+
+	/// <summary>
+	/// Spreads the low 16 bits of a value out so there is a zero between each of them.
+	/// </summary>
+	/// <param name="value">The value to spread.</param>
+	/// <returns>The spread value.</returns>
+	static uint32_t Part1By1(uint32_t value) noexcept;
+
+	/// <summary>
+	/// Sorts keys_ and order_ together with an LSD radix sort, 8 bits per pass.
+	/// Passes over bytes that are the same for every key are skipped.
+	/// </summary>
+	void RadixSort();
+
+	/// <summary>
+	/// The area the tree covers.
+	/// </summary>
+	AABB bounds_;
+
+	/// <summary>
+	/// The maximum depth of the tree.
+	/// </summary>
+	unsigned maxDepth_;
+
+	/// <summary>
+	/// Has the tree changed since the last Build()?
+	/// </summary>
+	bool dirty_;
+
+	/// <summary>
+	/// The objects in the tree, in no particular order.
+	/// </summary>
+	std::vector<T> objects_;
+
+	/// <summary>
+	/// The index of every object in objects_, so Remove does not have to search.
+	/// </summary>
+	std::unordered_map<T, unsigned> indices_;
+
+	/// <summary>
+	/// The sort keys from the last Build(), in sorted order.
+	/// </summary>
+	std::vector<uint64_t> keys_;
+
+	/// <summary>
+	/// The index into objects_ of each sorted key. Used while sorting.
+	/// </summary>
+	std::vector<unsigned> order_;
+
+	/// <summary>
+	/// The packed bounds from the last Build(), in sorted order.
+	/// </summary>
+	std::vector<float> minX_;
+	std::vector<float> minY_;
+	std::vector<float> maxX_;
+	std::vector<float> maxY_;
+
+	/// <summary>
+	/// The objects from the last Build(), in sorted order.
+	/// </summary>
+	std::vector<T> sorted_;
+
+	/// <summary>
+	/// Scratch buffers kept between builds so rebuilding every frame does not allocate.
+	/// </summary>
+	std::vector<uint64_t> keyScratch_;
+	std::vector<unsigned> orderScratch_;
+	std::vector<AABB> boundsScratch_;
+
+	/// <summary>
+	/// Reads the AABB of an item.
+	/// </summary>
+	[[no_unique_address]] BoundsFn boundsFn_;
+};
+
+#include "BasicLinearQuadtree.inl"
@@ -0,0 +1,357 @@
+﻿#pragma once
+/*******************************************************************************
+
+	@file BasicLinearQuadtree.inl
+
+	@date 10/17/2026 4:12:37 PM
+
+	@authors
+	Christian Wookey (christian.wookey@digipen.edu)
+
+	@brief
+	Pointerless quadtree that is rebuilt from scratch by sorting Morton codes.
+
+	@copyright All content © copyright 2020-2021, DigiPen (USA) Corporation 
+
+*******************************************************************************/
+
+/*****************************************************************************/
+/*                             PUBLIC FUNCTIONS                              */
+/*****************************************************************************/
+template<typename T, typename BoundsFn>
+BasicLinearQuadtree<T, BoundsFn>::BasicLinearQuadtree(unsigned maxDepth, AABB bounds, BoundsFn boundsFn) noexcept : bounds_(bounds), maxDepth_(std::min(maxDepth, MaxSupportedDepth)), dirty_(false), boundsFn_(std::move(boundsFn))
+{
+}
+
+template<typename T, typename BoundsFn>
+bool BasicLinearQuadtree<T, BoundsFn>::Insert(T object)
+{
+	if (!indices_.emplace(object, (unsigned)objects_.size()).second)
+		return false;
+
+	objects_.push_back(object);
+	dirty_ = true;
+	return true;
+}
+
+template<typename T, typename BoundsFn>
+bool BasicLinearQuadtree<T, BoundsFn>::Remove(T object)
+{
+	auto index = indices_.find(object);
+	if (index == indices_.end())
+		return false;
+
+	const unsigned slot = index->second;
+	indices_.erase(index);
+
+	// swap and pop, order does not matter until the next sort
+	if (slot + 1 != objects_.size())
+	{
+		objects_[slot] = objects_.back();
+		indices_[objects_[slot]] = slot;
+	}
+	objects_.pop_back();
+	dirty_ = true;
+	return true;
+}
+
+template<typename T, typename BoundsFn>
+void BasicLinearQuadtree<T, BoundsFn>::Clear() noexcept
+{
+	objects_.clear();
+	indices_.clear();
+	keys_.clear();
+	minX_.clear();
+	minY_.clear();
+	maxX_.clear();
+	maxY_.clear();
+	sorted_.clear();
+	dirty_ = false;
+}
+
+template<typename T, typename BoundsFn>
+void BasicLinearQuadtree<T, BoundsFn>::Resize(const AABB& newBounds) noexcept
+{
+	bounds_ = newBounds;
+	dirty_ = true;
+}
+
+template<typename T, typename BoundsFn>
+void BasicLinearQuadtree<T, BoundsFn>::BuildFrom(std::span<const T> objects)
+{
+	Clear();
+	objects_.assign(objects.begin(), objects.end());
+	indices_.reserve(objects_.size());
+	for (unsigned i = 0; i < objects_.size(); ++i)
+	{
+		indices_[objects_[i]] = i;
+	}
+	Build();
+}
+
+template<typename T, typename BoundsFn>
+void BasicLinearQuadtree<T, BoundsFn>::Build()
+{
+	const unsigned count = (unsigned)objects_.size();
+	keys_.resize(count);
+	order_.resize(count);
+	boundsScratch_.resize(count);
+	std::iota(order_.begin(), order_.end(), 0u);
+
+	// every key is independent, so they are computed in parallel
+	std::for_each(std::execution::par, order_.begin(), order_.end(), [&](unsigned i)
+	{
+		boundsScratch_[i] = boundsFn_(objects_[i]);
+		keys_[i] = GetKey(GetCell(boundsScratch_[i]));
+	});
+
+	RadixSort();
+
+	minX_.resize(count);
+	minY_.resize(count);
+	maxX_.resize(count);
+	maxY_.resize(count);
+	sorted_.resize(count);
+
+	// the sort is done with its scratch, so it holds the output indices. A parallel algorithm may
+	// hand the callable a copy of an element, so the index can't come from the element's address
+	orderScratch_.resize(count);
+	std::iota(orderScratch_.begin(), orderScratch_.end(), 0u);
+	std::for_each(std::execution::par, orderScratch_.begin(), orderScratch_.end(), [&](unsigned i)
+	{
+		const unsigned source = order_[i];
+		const AABB& bounds = boundsScratch_[source];
+		minX_[i] = bounds.Minimum().x;
+		minY_[i] = bounds.Minimum().y;
+		maxX_[i] = bounds.Maximum().x;
+		maxY_[i] = bounds.Maximum().y;
+		sorted_[i] = objects_[source];
+	});
+
+	dirty_ = false;
+}
+
+template<typename T, typename BoundsFn>
+bool BasicLinearQuadtree<T, BoundsFn>::IsDirty() const noexcept
+{
+	return dirty_;
+}
+
+template<typename T, typename BoundsFn>
+void BasicLinearQuadtree<T, BoundsFn>::GetCollisionCandidates(T object, _Inout_ std::vector<T>& collisionCandidates) const noexcept
+{
+	QueryRegion(boundsFn_(object), [&](T other)
+	{
+		if (!(other == object))
+			collisionCandidates.push_back(other);
+	});
+}
+
+template<typename T, typename BoundsFn>
+void BasicLinearQuadtree<T, BoundsFn>::QueryRegion(const AABB& area, _Inout_ std::vector<T>& results) const
+{
+	QueryRegion(area, [&](T object) { results.push_back(object); });
+}
+
+template<typename T, typename BoundsFn>
+void BasicLinearQuadtree<T, BoundsFn>::FindAllPairs(_Inout_ std::vector<ObjectPair>& pairs) const
+{
+	// descendants sort after their ancestors, so pairing each object with the rest of its own
+	// subtree range sees every pair exactly once
+	const unsigned count = (unsigned)sorted_.size();
+	for (unsigned i = 0; i < count; ++i)
+	{
+		const Cell cell{ (uint32_t)(keys_[i] >> 8), (unsigned)(keys_[i] & 0xff) };
+		const AABB bounds(minX_[i], minY_[i], maxX_[i], maxY_[i]);
+		const unsigned end = GetSubtreeRange(cell).second;
+
+		ForEachOverlap(bounds, { i + 1, end }, [&](unsigned j) { pairs.emplace_back(sorted_[i], sorted_[j]); });
+	}
+}
+
+template<typename T, typename BoundsFn>
+const AABB& BasicLinearQuadtree<T, BoundsFn>::GetBounds() const noexcept
+{
+	return bounds_;
+}
+
+template<typename T, typename BoundsFn>
+unsigned BasicLinearQuadtree<T, BoundsFn>::GetTotalObjects() const noexcept
+{
+	return (unsigned)objects_.size();
+}
+
+/*****************************************************************************/
+/*                            PRIVATE FUNCTIONS                              */
+/*****************************************************************************/
+template<typename T, typename BoundsFn>
+typename BasicLinearQuadtree<T, BoundsFn>::Cell BasicLinearQuadtree<T, BoundsFn>::GetCell(const AABB& bounds) const noexcept
+{
+	const uint32_t side = 1u << maxDepth_;
+	const float width = bounds_.Maximum().x - bounds_.Minimum().x;
+	const float height = bounds_.Maximum().y - bounds_.Minimum().y;
+	const float scaleX = width > 0.f ? (float)side / width : 0.f;
+	const float scaleY = height > 0.f ? (float)side / height : 0.f;
+
+	// anything outside the bounds is clamped to the edge cells, which keeps overlapping boxes in
+	// overlapping cells
+	auto quantize = [side](float value, float minimum, float scale) -> uint32_t
+	{
+		const float cell = (value - minimum) * scale;
+		if (!(cell > 0.f))
+			return 0;
+		if (cell >= (float)side)
+			return side - 1;
+		return (uint32_t)cell;
+	};
+
+	const uint32_t x0 = quantize(bounds.Minimum().x, bounds_.Minimum().x, scaleX);
+	const uint32_t y0 = quantize(bounds.Minimum().y, bounds_.Minimum().y, scaleY);
+	const uint32_t x1 = quantize(bounds.Maximum().x, bounds_.Minimum().x, scaleX);
+	const uint32_t y1 = quantize(bounds.Maximum().y, bounds_.Minimum().y, scaleY);
+
+	// the number of levels to climb is the highest bit where the two corners disagree
+	const unsigned shift = (unsigned)std::bit_width((x0 ^ x1) | (y0 ^ y1));
+	const uint32_t code = (Part1By1(x0 >> shift) | (Part1By1(y0 >> shift) << 1));
+
+	return Cell{ (uint32_t)((uint64_t)code << (2 * shift)), maxDepth_ - shift };
+}
+
+template<typename T, typename BoundsFn>
+uint64_t BasicLinearQuadtree<T, BoundsFn>::GetKey(Cell cell) noexcept
+{
+	return ((uint64_t)cell.code << 8) | cell.level;
+}
+
+template<typename T, typename BoundsFn>
+std::pair<unsigned, unsigned> BasicLinearQuadtree<T, BoundsFn>::GetSubtreeRange(Cell cell) const noexcept
+{
+	const uint64_t span = 1ull << (2 * (maxDepth_ - cell.level));
+	const auto first = std::lower_bound(keys_.begin(), keys_.end(), GetKey(cell));
+	const auto last = std::lower_bound(first, keys_.end(), ((uint64_t)cell.code + span) << 8);
+	return { (unsigned)(first - keys_.begin()), (unsigned)(last - keys_.begin()) };
+}
+
+template<typename T, typename BoundsFn>
+std::pair<unsigned, unsigned> BasicLinearQuadtree<T, BoundsFn>::GetCellRange(Cell cell) const noexcept
+{
+	const auto range = std::equal_range(keys_.begin(), keys_.end(), GetKey(cell));
+	return { (unsigned)(range.first - keys_.begin()), (unsigned)(range.second - keys_.begin()) };
+}
+
+template<typename T, typename BoundsFn>
+uint32_t BasicLinearQuadtree<T, BoundsFn>::Part1By1(uint32_t value) noexcept
+{
+	value &= 0x0000ffff;
+	value = (value | (value << 8)) & 0x00ff00ff;
+	value = (value | (value << 4)) & 0x0f0f0f0f;
+	value = (value | (value << 2)) & 0x33333333;
+	value = (value | (value << 1)) & 0x55555555;
+	return value;
+}
+
+template<typename T, typename BoundsFn>
+void BasicLinearQuadtree<T, BoundsFn>::RadixSort()
+{
+	const size_t count = keys_.size();
+	keyScratch_.resize(count);
+	orderScratch_.resize(count);
+
+	// 8 bits of level plus 2 bits of code per level of depth
+	const unsigned keyBits = 8 + 2 * maxDepth_;
+	for (unsigned shift = 0; shift < keyBits; shift += 8)
+	{
+		std::array<size_t, 256> histogram{};
+		for (uint64_t key : keys_)
+		{
+			histogram[(key >> shift) & 0xff]++;
+		}
+
+		// every key has the same byte here, so this pass would not move anything
+		if (std::find(histogram.begin(), histogram.end(), count) != histogram.end())
+			continue;
+
+		size_t offset = 0;
+		for (size_t& bucket : histogram)
+		{
+			const size_t size = bucket;
+			bucket = offset;
+			offset += size;
+		}
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			const size_t destination = histogram[(keys_[i] >> shift) & 0xff]++;
+			keyScratch_[destination] = keys_[i];
+			orderScratch_[destination] = order_[i];
+		}
+
+		keys_.swap(keyScratch_);
+		order_.swap(orderScratch_);
+	}
+}
+
+/*****************************************************************************/
+/*                            TEMPLATE FUNCTIONS                             */
+/*****************************************************************************/
+template<typename T, typename BoundsFn>
+template<typename Visitor> requires std::invocable<Visitor&, T>
+bool BasicLinearQuadtree<T, BoundsFn>::QueryRegion(const AABB& area, Visitor&& visitor) const
+{
+	const Cell cell = GetCell(area);
+	auto visit = [&](unsigned i) { return Visit(visitor, sorted_[i]); };
+
+	// the cell and everything below it
+	if (!ForEachOverlap(area, GetSubtreeRange(cell), visit))
+		return false;
+
+	// every cell above it
+	for (unsigned level = 0; level < cell.level; ++level)
+	{
+		const unsigned shift = 2 * (maxDepth_ - level);
+		const uint32_t code = (uint32_t)(cell.code & ~((1ull << shift) - 1));
+		if (!ForEachOverlap(area, GetCellRange(Cell{ code, level }), visit))
+			return false;
+	}
+	return true;
+}
+
+template<typename T, typename BoundsFn>
+template<typename Visitor>
+bool BasicLinearQuadtree<T, BoundsFn>::ForEachOverlap(const AABB& area, std::pair<unsigned, unsigned> range, Visitor&& visitor) const
+{
+	// hits are compacted into a stack buffer, so large ranges are tested in chunks
+	constexpr unsigned ChunkSize = 256;
+	unsigned hits[ChunkSize];
+
+	for (unsigned first = range.first; first < range.second; first += ChunkSize)
+	{
+		const unsigned count = std::min(ChunkSize, range.second - first);
+		const unsigned hitCount = BatchOverlaps(
+			minX_.data() + first, minY_.data() + first,
+			maxX_.data() + first, maxY_.data() + first,
+			count, area, hits);
+
+		for (unsigned h = 0; h < hitCount; ++h)
+		{
+			if (!Visit(visitor, first + hits[h]))
+				return false;
+		}
+	}
+	return true;
+}
+
+template<typename T, typename BoundsFn>
+template<typename Visitor, typename... Args>
+bool BasicLinearQuadtree<T, BoundsFn>::Visit(Visitor& visitor, Args&&... args)
+{
+	if constexpr (std::is_void_v<std::invoke_result_t<Visitor&, Args...>>)
+	{
+		visitor(std::forward<Args>(args)...);
+		return true;
+	}
+	else
+	{
+		return static_cast<bool>(visitor(std::forward<Args>(args)...));
+	}
+}
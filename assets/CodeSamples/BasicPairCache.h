@@ -0,0 +1,220 @@
+﻿#pragma once
+/*******************************************************************************
+
+	@file BasicPairCache.h
+
+	@date 10/17/2026 6:41:52 PM
+
+	@authors
+	Christian Wookey (christian.wookey@digipen.edu)
+
+	@brief
+	Keeps overlapping pairs between frames and reports when they begin and end.
+
+	@copyright All content © copyright 2020-2021, DigiPen (USA) Corporation 
+
+*******************************************************************************/
+
+#include "BasicQuadtree.h"
+#include "FatAABB.h"
+#include <unordered_set>
+
+/// <summary>
+/// Remembers which objects overlapped last frame so enter and exit callbacks can be driven
+/// from the broadphase. Each object is stored in a BasicQuadtree with a fat AABB, its real AABB
+/// grown by a margin. The tree is only updated and queried for an object once its real AABB
+/// leaves its fat AABB, so objects that are asleep or moving slowly cost one bounds read per frame.
+/// T and BoundsFn work the same way as in BasicQuadtree. PairCache is the version that stores GameObject pointers.
+/// </summary>
+template<typename T, typename BoundsFn>
+class BasicPairCache
+{
+public:
+
+	/// <summary>
+	/// Two objects whose AABBs overlap, ordered with std::less so each pair has one key.
+	/// </summary>
+	using ObjectPair = std::pair<T, T>;
+
+	/// <summary>
+	/// What happened to a pair of objects this frame.
+	/// </summary>
+	enum class EventType
+	{
+		Begin,   // the AABBs started overlapping
+		Persist, // the AABBs overlapped last frame and still do
+		End      // the AABBs stopped overlapping, or one of the objects was removed
+	};
+
+	/// <summary>
+	/// A change in the overlap of two objects.
+	/// </summary>
+	struct Event
+	{
+		EventType type;
+		T first;
+		T second;
+	};
+
+	/// <summary>
+	/// Default constructor.
+	/// </summary>
+	/// <returns>A new BasicPairCache with the default settings</returns>
+	BasicPairCache() : BasicPairCache(AABB(-10.f, -10.f, 10.f, 10.f)) {}
+
+	/// <summary>
+	/// Non-default constructor.
+	/// </summary>
+	/// <param name="bounds">The area that the tree covers.</param>
+	/// <returns>A new BasicPairCache with the specified bounds</returns>
+	BasicPairCache(AABB bounds) : BasicPairCache(6, 8, bounds, 0.1f) {}
+
+	/// <summary>
+	/// Non-default constructor.
+	/// </summary>
+	/// <param name="maxDepth">Maximum depth of the tree.</param>
+	/// <param name="maxObjects">The maximum number of objects stored in one node.</param>
+	/// <param name="bounds">The area that the tree covers.</param>
+	/// <param name="margin">How far each side of an AABB is pushed out to make its fat AABB.</param>
+	/// <param name="boundsFn">Reads the AABB of an item.</param>
+	/// <returns>A new BasicPairCache with a specified bounds, max depth, max objects and margin.</returns>
+	BasicPairCache(unsigned maxDepth, unsigned maxObjects, AABB bounds, float margin, BoundsFn boundsFn = BoundsFn());
+
+	/// destructor
+	~BasicPairCache() = default;
+
+	BasicPairCache(const BasicPairCache&) = default;
+	BasicPairCache& operator=(const BasicPairCache&) = default;
+
+	BasicPairCache(BasicPairCache&&) = default;
+	BasicPairCache& operator=(BasicPairCache&&) = default;
+
+	/// <summary>
+	/// Starts tracking an object. Its pairs are found on the next Update().
+	/// </summary>
+	/// <param name="object">The object to add.</param>
+	/// <returns>true if the object was added, false if it was already tracked or the tree is frozen.</returns>
+	bool Insert(T object);
+
+	/// <summary>
+	/// Stops tracking an object. Its touching pairs are reported as ended on the next Update().
+	/// </summary>
+	/// <param name="object">The object to remove.</param>
+	/// <returns>true if the object was found, false otherwise.</returns>
+	bool Remove(T object);
+
+	/// <summary>
+	/// Stops tracking every object. No End events are reported for pairs that were touching.
+	/// </summary>
+	void Clear();
+
+	/// <summary>
+	/// Reads the AABB of every object, moves the ones that left their fat AABB, and reports
+	/// every pair that began, persisted or ended since the last call.
+	/// Only objects that moved or were inserted are searched for in the tree.
+	/// </summary>
+	/// <param name="events">The vector the events are appended to.</param>
+	void Update(_Inout_ std::vector<Event>& events);
+
+	/// <summary>
+	/// Sets how far each side of an AABB is pushed out to make its fat AABB. A bigger margin
+	/// means fewer tree updates but more pairs to test. Takes effect as objects next move.
+	/// </summary>
+	/// <param name="margin">The margin, clamped to at least 0.</param>
+	void SetMargin(float margin) noexcept;
+
+	/// <summary>
+	/// Gets how far each side of an AABB is pushed out to make its fat AABB.
+	/// </summary>
+	/// <returns>The margin.</returns>
+	float GetMargin() const noexcept;
+
+	/// <summary>
+	/// Gets the tree of fat AABBs.
+	/// </summary>
+	/// <returns>The tree.</returns>
+	const BasicQuadtree<T, BoundsFn>& GetTree() const noexcept;
+
+	/// <summary>
+	/// Counts the number of objects being tracked.
+	/// </summary>
+	/// <returns>the number of objects being tracked</returns>
+	unsigned GetTotalObjects() const noexcept;
+
+private:
+
+	/// <summary>
+	/// An object and the AABBs it was last seen with.
+	/// </summary>
+	struct Proxy
+	{
+		T object;
+		AABB bounds;  // the AABB read this frame
+		AABB fat;     // the AABB stored in the tree
+		bool moved;   // the fat AABB changed, so the object needs to be searched for
+	};
+
+	/// <summary>
+	/// Hashes an ObjectPair by combining the hashes of both objects.
+	/// </summary>
+	struct PairHash
+	{
+		size_t operator()(const ObjectPair& pair) const noexcept
+		{
+			const size_t first = std::hash<T>()(pair.first);
+			return first ^ (std::hash<T>()(pair.second) + 0x9e3779b9 + (first << 6) + (first >> 2));
+		}
+	};
+
+	/// <summary>
+	/// Orders two objects so the same pair always has the same key.
+	/// </summary>
+	/// <param name="a">One object.</param>
+	/// <param name="b">The other object.</param>
+	/// <returns>The pair with the lesser object first.</returns>
+	static ObjectPair MakePair(T a, T b);
+
+	/// <summary>
+	/// Looks up the proxy of an object.
+	/// </summary>
+	/// <param name="object">The object to check.</param>
+	/// <returns>The object's proxy, or nullptr if it was removed.</returns>
+	const Proxy* FindProxy(T object) const;
+
+	/// <summary>
+	/// The fat AABBs of every object.
+	/// </summary>
+	BasicQuadtree<T, BoundsFn> tree_;
+
+	/// <summary>
+	/// Every tracked object, packed so the per frame bounds check walks memory in order.
+	/// </summary>
+	std::vector<Proxy> proxies_;
+
+	/// <summary>
+	/// The index of each object in proxies_.
+	/// </summary>
+	std::unordered_map<T, unsigned> index_;
+
+	/// <summary>
+	/// Every pair whose fat AABBs overlap, and whether their AABBs overlapped last frame.
+	/// </summary>
+	std::unordered_map<ObjectPair, bool, PairHash> pairs_;
+
+	/// <summary>
+	/// Pairs found by searching for moved objects this frame. Kept between frames to reuse its buckets.
+	/// </summary>
+	std::unordered_set<ObjectPair, PairHash> fresh_;
+
+	/// <summary>
+	/// How far each side of an AABB is pushed out to make its fat AABB.
+	/// </summary>
+	float margin_;
+
+	/// <summary>
+	/// Reads the AABB of an item.
+	/// </summary>
+	[[no_unique_address]] BoundsFn boundsFn_;
+};
+
+#include "BasicPairCache.inl"
@@ -0,0 +1,176 @@
+﻿#pragma once
+/*******************************************************************************
+
+	@file BasicPairCache.inl
+
+	@date 10/17/2026 6:41:52 PM
+
+	@authors
+	Christian Wookey (christian.wookey@digipen.edu)
+
+	@brief
+	Keeps overlapping pairs between frames and reports when they begin and end.
+
+	@copyright All content © copyright 2020-2021, DigiPen (USA) Corporation 
+
+*******************************************************************************/
+
+/*****************************************************************************/
+/*                             PUBLIC FUNCTIONS                              */
+/*****************************************************************************/
+template<typename T, typename BoundsFn>
+BasicPairCache<T, BoundsFn>::BasicPairCache(unsigned maxDepth, unsigned maxObjects, AABB bounds, float margin, BoundsFn boundsFn) : tree_(maxDepth, maxObjects, bounds, boundsFn), margin_(std::max(margin, 0.f)), boundsFn_(std::move(boundsFn))
+{
+}
+
+template<typename T, typename BoundsFn>
+bool BasicPairCache<T, BoundsFn>::Insert(T object)
+{
+	if (index_.find(object) != index_.end())
+		return false;
+
+	const AABB bounds = boundsFn_(object);
+	const AABB fat = FattenAABB(bounds, margin_);
+	if (!tree_.Insert(object, fat))
+		return false;
+
+	index_.emplace(object, static_cast<unsigned>(proxies_.size()));
+	proxies_.push_back(Proxy{ object, bounds, fat, true });
+	return true;
+}
+
+template<typename T, typename BoundsFn>
+bool BasicPairCache<T, BoundsFn>::Remove(T object)
+{
+	auto found = index_.find(object);
+	if (found == index_.end())
+		return false;
+
+	tree_.Remove(object);
+
+	// swap the last proxy into the hole so proxies_ stays packed
+	const unsigned slot = found->second;
+	index_.erase(found);
+	if (slot != proxies_.size() - 1)
+	{
+		proxies_[slot] = proxies_.back();
+		index_[proxies_[slot].object] = slot;
+	}
+	proxies_.pop_back();
+
+	// pairs with the object are dropped on the next Update(), once it can report them as ended
+	return true;
+}
+
+template<typename T, typename BoundsFn>
+void BasicPairCache<T, BoundsFn>::Clear()
+{
+	tree_.Clear();
+	proxies_.clear();
+	index_.clear();
+	pairs_.clear();
+	fresh_.clear();
+}
+
+template<typename T, typename BoundsFn>
+void BasicPairCache<T, BoundsFn>::Update(_Inout_ std::vector<Event>& events)
+{
+	// only objects that left their fat AABB touch the tree
+	for (Proxy& proxy : proxies_)
+	{
+		proxy.bounds = boundsFn_(proxy.object);
+		if (!ContainsAABB(proxy.fat, proxy.bounds))
+		{
+			proxy.fat = FattenAABB(proxy.bounds, margin_);
+			tree_.UpdateBounds(proxy.object, proxy.fat);
+			proxy.moved = true;
+		}
+	}
+
+	fresh_.clear();
+	for (const Proxy& proxy : proxies_)
+	{
+		if (!proxy.moved)
+			continue;
+
+		tree_.QueryRegion(proxy.fat, [&](T other)
+		{
+			if (!(other == proxy.object))
+				fresh_.insert(MakePair(proxy.object, other));
+		});
+	}
+
+	// a pair of objects that both stayed inside their fat AABBs still overlaps, so it is kept
+	// without searching. Any other pair is kept only if it was found again.
+	for (auto pair = pairs_.begin(); pair != pairs_.end();)
+	{
+		const Proxy* first = FindProxy(pair->first.first);
+		const Proxy* second = FindProxy(pair->first.second);
+		const bool removed = !first || !second;
+		if (removed || ((first->moved || second->moved) && fresh_.find(pair->first) == fresh_.end()))
+		{
+			if (pair->second)
+				events.push_back(Event{ EventType::End, pair->first.first, pair->first.second });
+			pair = pairs_.erase(pair);
+		}
+		else
+			++pair;
+	}
+
+	for (const ObjectPair& pair : fresh_)
+		pairs_.emplace(pair, false);
+
+	// every pair whose AABBs overlap also has overlapping fat AABBs, so only cached pairs are tested
+	for (auto& [pair, touching] : pairs_)
+	{
+		const bool overlaps = FindProxy(pair.first)->bounds.Overlaps(FindProxy(pair.second)->bounds);
+		if (overlaps)
+			events.push_back(Event{ touching ? EventType::Persist : EventType::Begin, pair.first, pair.second });
+		else if (touching)
+			events.push_back(Event{ EventType::End, pair.first, pair.second });
+		touching = overlaps;
+	}
+
+	for (Proxy& proxy : proxies_)
+		proxy.moved = false;
+}
+
+template<typename T, typename BoundsFn>
+void BasicPairCache<T, BoundsFn>::SetMargin(float margin) noexcept
+{
+	margin_ = std::max(margin, 0.f);
+}
+
+template<typename T, typename BoundsFn>
+float BasicPairCache<T, BoundsFn>::GetMargin() const noexcept
+{
+	return margin_;
+}
+
+template<typename T, typename BoundsFn>
+const BasicQuadtree<T, BoundsFn>& BasicPairCache<T, BoundsFn>::GetTree() const noexcept
+{
+	return tree_;
+}
+
+template<typename T, typename BoundsFn>
+unsigned BasicPairCache<T, BoundsFn>::GetTotalObjects() const noexcept
+{
+	return static_cast<unsigned>(proxies_.size());
+}
+
+/*****************************************************************************/
+/*                            PRIVATE FUNCTIONS                              */
+/*****************************************************************************/
+template<typename T, typename BoundsFn>
+typename BasicPairCache<T, BoundsFn>::ObjectPair BasicPairCache<T, BoundsFn>::MakePair(T a, T b)
+{
+	return std::less<T>()(b, a) ? ObjectPair(b, a) : ObjectPair(a, b);
+}
+
+template<typename T, typename BoundsFn>
+const typename BasicPairCache<T, BoundsFn>::Proxy* BasicPairCache<T, BoundsFn>::FindProxy(T object) const
+{
+	auto found = index_.find(object);
+	return found == index_.end() ? nullptr : &proxies_[found->second];
+}
@@ -0,0 +1,1588 @@
+﻿#pragma once
+/*******************************************************************************
+
+	@file BasicQuadtree.h
+
+	@date 10/17/2026 4:12:37 PM
+
+	@authors
+	Christian Wookey (christian.wookey@digipen.edu)
+
+	@brief
+	Quadtree over any item type, used to reduce the number of collision checks.
+
+	@copyright All content © copyright 2020-2021, DigiPen (USA) Corporation 
+
+*******************************************************************************/
+
+#include "AABB.h"
+#include "OverlapKernel.h"
+#include "FatAABB.h"
+#include <array>
+#include <vector>
+#include <memory>
+#include <utility>
+#include <algorithm>
+#include <unordered_map>
+#include <span>
+#include <concepts>
+#include <type_traits>
+#include <functional>
+#include <atomic>
+#include <thread>
+#include <execution>
+#include <cfloat>
+#include <queue>
+#include <cstdint>
+
+// Define QUADTREE_STATS to compile in the counters behind GetStats(). Without it they cost nothing.
+#ifdef QUADTREE_STATS
+#define QUADTREE_STAT(statement) statement
+#else
+#define QUADTREE_STAT(statement)
+#endif
+
+#ifdef QUADTREE_STATS
+/// <summary>
+/// A snapshot of the shape of a tree and the work it has done since its counters were last reset.
+/// Query costs cover QueryRegion, QueryPoint, QueryRadius and GetCollisionCandidates.
+/// </summary>
+struct QuadtreeStats
+{
+	std::vector<unsigned> nodesPerDepth; // the number of nodes at each depth, the root is depth 0
+	unsigned nodeCount = 0;              // every node, including the root
+	unsigned totalObjects = 0;           // every object in the tree
+	unsigned rootObjects = 0;            // objects that could not be pushed below the root
+	unsigned maxBucketSize = 0;          // the most objects stored in one node
+	float averageBucketSize = 0.f;       // objects per node, over the nodes that hold any
+
+	uint64_t branches = 0;               // nodes that split into children
+	uint64_t collapses = 0;              // nodes whose children were merged back into them
+	uint64_t queries = 0;                // searches run
+	uint64_t nodesVisited = 0;           // nodes the searches walked into
+	uint64_t overlapTests = 0;           // AABBs tested against a search area
+	uint64_t candidates = 0;             // objects the searches returned
+
+	float nodesPerQuery = 0.f;           // nodesVisited / queries
+	float candidatesPerQuery = 0.f;      // candidates / queries
+	float falsePositiveRatio = 0.f;      // tests that returned nothing / overlapTests
+};
+#endif // QUADTREE_STATS
+
+/// <summary>
+/// A quadtree of items of type T. T is a small value that identifies an object, such as a pointer,
+/// a handle or an index, and must be hashable with std::hash and comparable with ==.
+/// BoundsFn is a function object that returns the current AABB of an item: AABB BoundsFn::operator()(const T&).
+/// It is stored in the tree, so it can carry state such as a pointer to an array of bounds.
+/// Quadtree is the version used by the engine, which stores GameObject pointers.
+/// </summary>
+template<typename T, typename BoundsFn>
+class BasicQuadtree
+{
+public:
+
+	/// <summary>
+	/// Two objects whose AABBs overlap.
+	/// </summary>
+	using ObjectPair = std::pair<T, T>;
+
+	/// <summary>
+	/// The type of item stored in the tree.
+	/// </summary>
+	using ItemType = T;
+
+	/// <summary>
+	/// One bit per collision layer. A query only finds objects that share at least one bit with its mask.
+	/// </summary>
+	using LayerMask = uint32_t;
+
+	/// <summary>
+	/// Every layer. Objects are on every layer until SetLayers() is called for them.
+	/// </summary>
+	static constexpr LayerMask AllLayers = ~LayerMask(0);
+
+	/// <summary>
+	/// The closest object hit by a RayCast.
+	/// </summary>
+	struct RayHit
+	{
+		/// <summary>
+		/// The object that was hit. Only valid if RayCast returned true.
+		/// </summary>
+		T object{};
+
+		/// <summary>
+		/// How far along the segment the hit is, 0 at the start and 1 at the end.
+		/// </summary>
+		float fraction = 1.f;
+	};
+
+	/// <summary>
+	/// Default constructor.
+	/// </summary>
+	/// <returns>A new Quadtree with the default settings</returns>
+	BasicQuadtree() : BasicQuadtree(AABB(-10.f, -10.f, 10.f, 10.f)) {}
+
+	/// <summary>
+	/// Non-default constructor.
+	/// </summary>
+	/// <param name="bounds">The area that the Quadtree covers.</param>
+	/// <returns>A new Quadtree with the specified bounds</returns>
+	BasicQuadtree(AABB bounds) : BasicQuadtree(6, 8, bounds) {}
+
+	/// <summary>
+	/// Non-default constructor.
+	/// </summary>
+	/// <param name="maxDepth">Maximum depth of the tree</param>
+	/// <param name="maxObjects">The maximum number of objects stored in one node.</param>
+	/// <param name="bounds">The area that the Quadtree covers.</param>
+	/// <param name="boundsFn">Reads the AABB of an item.</param>
+	/// <returns>A new Quadtree with a specified  bounds, max depth and max objects.</returns>
+	BasicQuadtree(unsigned maxDepth, unsigned maxObjects, AABB bounds, BoundsFn boundsFn = BoundsFn());
+
+	/// destructor
+	~BasicQuadtree() = default;
+	
+	/// <summary>
+	/// Copy constructor. O(n) in the number of objects, because the map from each object to its node
+	/// and the queued commands are copied. The nodes themselves are shared, and each block of nodes is
+	/// copied the first time either tree changes it. Use TakeSnapshot() for an O(1) read only copy.
+	/// </summary>
+	BasicQuadtree(const BasicQuadtree& other);
+
+	/// <summary>
+	/// Copy assignment operator. O(n) in the number of objects, like the copy constructor.
+	/// </summary>
+	BasicQuadtree& operator=(const BasicQuadtree& other);
+	
+	/// <summary>
+	/// Move constructor. Takes the other tree's nodes without copying or touching them. The other
+	/// tree is left empty, with the bounds and maximum depth it was made with.
+	/// </summary>
+	BasicQuadtree(BasicQuadtree&& other);
+
+	/// <summary>
+	/// Move assignment operator. Swaps the two trees, so the other tree is left holding this one's old contents.
+	/// </summary>
+	BasicQuadtree& operator=(BasicQuadtree&& other) noexcept;
+
+	/// <summary>
+	/// Swaps the contents and settings of two trees in constant time. No nodes are copied or touched.
+	/// </summary>
+	/// <param name="other">The tree to swap with.</param>
+	void Swap(BasicQuadtree& other) noexcept;
+
+	/// <summary>
+	/// Swaps two trees. Lets std::swap and std::ranges::swap find BasicQuadtree::Swap.
+	/// </summary>
+	friend void swap(BasicQuadtree& a, BasicQuadtree& b) noexcept { a.Swap(b); }
+
+
+
+	/// Most of the public functions in Quadtree are helper functions which call the corresponding
+	/// recursive function on the root node of the tree.
+
+	/// <summary>
+	/// Adds an object to the tree, branching if needed.
+	/// </summary>
+	/// <param name="object">The object to add.</param>
+	/// <returns>true if the object was inserted successfully, false otherwise.</returns>
+	bool Insert(T object);
+
+	/// <summary>
+	/// Adds an object to the tree with a given AABB instead of reading its own. Queries test
+	/// against the given AABB, so it can be grown to hold the object for several frames.
+	/// </summary>
+	/// <param name="object">The object to add.</param>
+	/// <param name="bounds">The AABB to store the object with.</param>
+	/// <returns>true if the object was inserted successfully, false if it is already in the tree or bounds is not finite.</returns>
+	bool Insert(T object, const AABB& bounds);
+	
+	/// <summary>
+	/// Clears the tree and bulk loads it with a set of objects.
+	/// The objects are partitioned into quadrants top down in place instead of being inserted one
+	/// by one, and independent subtrees are partitioned in parallel. Much faster than calling Insert()
+	/// for every object when the tree is rebuilt from scratch. Every object must be unique.
+	/// Objects whose bounds are not finite are left out.
+	/// </summary>
+	/// <param name="objects">The objects to store in the tree.</param>
+	/// <returns>true if the tree was built, false if it is frozen.</returns>
+	bool BuildFrom(std::span<const T> objects);
+
+	/// <summary>
+	/// Find and removes an object from the tree in constant time.
+	/// Works no matter how the object's AABB changed since it was inserted.
+	/// </summary>
+	/// <param name="object">The object to remove.</param>
+	/// <returns>true if the object was found, false otherwise.</returns>
+	bool Remove(T object);
+
+	/// <summary>
+	/// Moves an object that is already in the tree to match its current AABB.
+	/// The object stays in its node when it still belongs there, otherwise it climbs to the
+	/// nearest ancestor that can hold it and is inserted back down from there.
+	/// Much cheaper than Remove() followed by Insert() for objects that only moved slightly.
+	/// With a fat margin, does nothing while the AABB is still inside the object's fat AABB.
+	/// </summary>
+	/// <param name="object">The object that moved.</param>
+	/// <returns>true if the object was found, false otherwise.</returns>
+	bool Update(T object);
+
+	/// <summary>
+	/// Moves an object that is already in the tree to match its current AABB, and stretches its
+	/// fat AABB along how far it moved this frame so it can keep moving without leaving it.
+	/// Does nothing while the AABB is still inside the fat AABB stored for the object.
+	/// </summary>
+	/// <param name="object">The object that moved.</param>
+	/// <param name="displacement">How far the object moved since the last update.</param>
+	/// <returns>true if the object was found, false otherwise.</returns>
+	bool Update(T object, const DirectX::SimpleMath::Vector2& displacement);
+
+	/// <summary>
+	/// Moves an object that is already in the tree to match a given AABB instead of reading its own.
+	/// </summary>
+	/// <param name="object">The object that moved.</param>
+	/// <param name="newBounds">The AABB to store the object with.</param>
+	/// <returns>true if the object was found, false if it wasn't or newBounds is not finite.</returns>
+	bool UpdateBounds(T object, const AABB& newBounds);
+
+	/// <summary>
+	/// Sets the collision layers an object is on. Masked queries skip it, and any subtree or
+	/// node that only holds objects on other layers, without testing their AABBs.
+	/// </summary>
+	/// <param name="object">The object to change.</param>
+	/// <param name="layers">The layers the object is on.</param>
+	/// <returns>true if the object was found, false otherwise.</returns>
+	bool SetLayers(T object, LayerMask layers);
+
+	/// <summary>
+	/// Gets the collision layers an object is on.
+	/// </summary>
+	/// <param name="object">The object to check.</param>
+	/// <returns>The object's layers, or 0 if it is not in the tree.</returns>
+	LayerMask GetLayers(T object) const;
+
+	/// <summary>
+	/// Records an insert to be applied by the next Commit() instead of descending the tree now.
+	/// </summary>
+	/// <param name="object">The object to add.</param>
+	void QueueInsert(T object);
+
+	/// <summary>
+	/// Records a remove to be applied by the next Commit().
+	/// </summary>
+	/// <param name="object">The object to remove.</param>
+	void QueueRemove(T object);
+
+	/// <summary>
+	/// Records that an object moved, to be applied by the next Commit().
+	/// </summary>
+	/// <param name="object">The object that moved.</param>
+	void QueueUpdate(T object);
+
+	/// <summary>
+	/// Applies every queued command in one step. Only the last state of each object counts, so
+	/// an object inserted and removed in the same frame never touches the tree. Removes run first,
+	/// then moves, then inserts sorted by the node they land in. Collapsing waits until the end,
+	/// and then only walks up from the nodes that lost objects instead of searching the whole tree.
+	/// The tree is safe for read only queries once this returns.
+	/// </summary>
+	/// <returns>true if the commands were applied, false if the tree is frozen and they are still queued.</returns>
+	bool Commit();
+
+	/// <summary>
+	/// Counts the commands waiting for Commit().
+	/// </summary>
+	/// <returns>The number of queued commands.</returns>
+	size_t GetQueuedCommandCount() const noexcept;
+
+	/// <summary>
+	/// Clears the quadtree of all objects and nodes. Queued commands are kept.
+	/// If the tree grew, it goes back to its original bounds and maximum depth.
+	/// </summary>
+	void Clear();
+
+	/// <summary>
+	/// Sets a new size for the quadtree. Every object is inserted again so the nodes match the new size.
+	/// Undoes any growing first, so the maximum depth goes back to the one the tree was made with.
+	/// </summary>
+	/// <param name="newBounds">The new size of the quadtree.</param>
+	void Resize(const AABB& newBounds);
+
+	/// <summary>
+	/// Given an object, find all the objects in the tree that overlap its AABB.
+	/// Read only. Safe to call from many threads at once while the tree is frozen.
+	/// </summary>
+	/// <param name="object">The object to check</param>
+	/// <param name="collisionCandidates">A reference to a vector of T</param>
+	void GetCollisionCandidates(T object, _Inout_ std::vector<T>& collisionCandidates) const noexcept;
+
+	/// <summary>
+	/// Given an object, calls a visitor with each object in the tree that overlaps its AABB.
+	/// Nothing is allocated, so the caller decides where the candidates go.
+	/// </summary>
+	/// <param name="object">The object to check</param>
+	/// <param name="visitor">Called as visitor(T) for each candidate. May return false to stop the search.</param>
+	/// <returns>false if the visitor stopped the search.</returns>
+	template<typename Visitor> requires std::invocable<Visitor&, T>
+	bool GetCollisionCandidates(T object, Visitor&& visitor) const;
+
+	/// <summary>
+	/// Given an object, find all the objects in the tree on the given layers that overlap its AABB.
+	/// </summary>
+	/// <param name="object">The object to check</param>
+	/// <param name="mask">The layers to find objects on.</param>
+	/// <param name="collisionCandidates">A reference to a vector of T</param>
+	void GetCollisionCandidates(T object, LayerMask mask, _Inout_ std::vector<T>& collisionCandidates) const;
+
+	/// <summary>
+	/// Given an object, calls a visitor with each object in the tree on the given layers that overlaps its AABB.
+	/// </summary>
+	/// <param name="object">The object to check</param>
+	/// <param name="mask">The layers to find objects on.</param>
+	/// <param name="visitor">Called as visitor(T) for each candidate. May return false to stop the search.</param>
+	/// <returns>false if the visitor stopped the search.</returns>
+	template<typename Visitor> requires std::invocable<Visitor&, T>
+	bool GetCollisionCandidates(T object, LayerMask mask, Visitor&& visitor) const;
+
+	/// <summary>
+	/// Runs GetCollisionCandidates for many objects across several threads. The tree must be frozen.
+	/// Threads take small chunks of the objects from a shared counter until none are left, and
+	/// each thread writes only to its own result buffer.
+	/// </summary>
+	/// <param name="objects">The objects to find candidates for.</param>
+	/// <param name="results">One buffer of (object, candidate) pairs per thread. Resized and cleared.</param>
+	/// <param name="threadCount">The number of threads to use, including the calling thread. 0 uses every core.</param>
+	/// <returns>true if the queries ran, false if the tree is not frozen.</returns>
+	bool GetCollisionCandidatesParallel(std::span<const T> objects, _Inout_ std::vector<std::vector<ObjectPair>>& results, unsigned threadCount = 0) const;
+
+	/// <summary>
+	/// Ends the build phase. While frozen the tree cannot be changed: Insert, Remove and Update
+	/// return false and Clear and Resize do nothing. In exchange any number of threads may query it.
+	/// </summary>
+	void Freeze() noexcept;
+
+	/// <summary>
+	/// Ends the read phase so the tree can be changed again. No thread may be querying the tree.
+	/// </summary>
+	void Thaw() noexcept;
+
+	/// <summary>
+	/// Is the tree frozen?
+	/// </summary>
+	/// <returns>true between Freeze() and Thaw().</returns>
+	bool IsFrozen() const noexcept;
+
+	/// <summary>
+	/// Finds every pair of objects in the tree whose AABBs overlap, in a single pass.
+	/// Each unordered pair is reported exactly once and objects are never paired with themselves.
+	/// Not safe to call from more than one thread at a time, it reuses an internal scratch buffer.
+	/// </summary>
+	/// <param name="pairs">The vector the overlapping pairs are appended to.</param>
+	void FindAllPairs(_Inout_ std::vector<ObjectPair>& pairs);
+
+	/// <summary>
+	/// Finds every object whose AABB overlaps an area.
+	/// </summary>
+	/// <param name="area">The area to search.</param>
+	/// <param name="results">The vector the objects are added to.</param>
+	void QueryRegion(const AABB& area, _Inout_ std::vector<T>& results) const;
+
+	/// <summary>
+	/// Calls a visitor with every object whose AABB overlaps an area, without allocating.
+	/// </summary>
+	/// <param name="area">The area to search.</param>
+	/// <param name="visitor">Called as visitor(T) for each object. May return false to stop the search.</param>
+	/// <returns>false if the visitor stopped the search.</returns>
+	template<typename Visitor> requires std::invocable<Visitor&, T>
+	bool QueryRegion(const AABB& area, Visitor&& visitor) const;
+
+	/// <summary>
+	/// Finds every object on the given layers whose AABB overlaps an area.
+	/// </summary>
+	/// <param name="area">The area to search.</param>
+	/// <param name="mask">The layers to find objects on.</param>
+	/// <param name="results">The vector the objects are added to.</param>
+	void QueryRegion(const AABB& area, LayerMask mask, _Inout_ std::vector<T>& results) const;
+
+	/// <summary>
+	/// Calls a visitor with every object on the given layers whose AABB overlaps an area, without allocating.
+	/// </summary>
+	/// <param name="area">The area to search.</param>
+	/// <param name="mask">The layers to find objects on.</param>
+	/// <param name="visitor">Called as visitor(T) for each object. May return false to stop the search.</param>
+	/// <returns>false if the visitor stopped the search.</returns>
+	template<typename Visitor> requires std::invocable<Visitor&, T>
+	bool QueryRegion(const AABB& area, LayerMask mask, Visitor&& visitor) const;
+
+	/// <summary>
+	/// Calls a visitor with every object in the tree and the AABB it was stored with.
+	/// </summary>
+	/// <param name="visitor">Called as visitor(T, const AABB&) for each object.</param>
+	template<typename Visitor>
+	void ForEachObject(Visitor&& visitor) const;
+
+	/// <summary>
+	/// Finds every object whose AABB contains a point.
+	/// </summary>
+	/// <param name="point">The point to search.</param>
+	/// <param name="results">The vector the objects are added to.</param>
+	void QueryPoint(const DirectX::SimpleMath::Vector2& point, _Inout_ std::vector<T>& results) const;
+
+	/// <summary>
+	/// Finds every object whose AABB is within a distance of a point.
+	/// </summary>
+	/// <param name="center">The center of the circle to search.</param>
+	/// <param name="radius">The radius of the circle to search.</param>
+	/// <param name="results">The vector the objects are added to.</param>
+	void QueryRadius(const DirectX::SimpleMath::Vector2& center, float radius, _Inout_ std::vector<T>& results) const;
+
+	/// <summary>
+	/// Finds the first object whose AABB is hit by a line segment.
+	/// Nodes are visited front to back and any node the segment reaches after the closest hit so far is skipped.
+	/// </summary>
+	/// <param name="start">The start of the segment.</param>
+	/// <param name="end">The end of the segment.</param>
+	/// <param name="hit">Receives the closest hit.</param>
+	/// <returns>true if something was hit.</returns>
+	bool RayCast(const DirectX::SimpleMath::Vector2& start, const DirectX::SimpleMath::Vector2& end, _Out_ RayHit& hit) const;
+
+	/// <summary>
+	/// Finds the objects whose AABBs are closest to a point, using a best first search.
+	/// </summary>
+	/// <param name="point">The point to search from.</param>
+	/// <param name="count">The number of objects to find.</param>
+	/// <param name="nearest">The vector the objects are added to, closest first.</param>
+	void QueryNearest(const DirectX::SimpleMath::Vector2& point, unsigned count, _Inout_ std::vector<T>& nearest) const;
+
+	/// <summary>
+	/// Gets the bounds.
+	/// </summary>
+	/// <returns>A constant AABB reference to the bounds of the tree.</returns>
+	const AABB& GetBounds() const noexcept;
+
+#ifdef _DEBUG
+	/// <summary>
+	/// Draws a debug version of the tree using ImGui.
+	/// Only defined for Quadtree, because it draws the colliders of each GameObject.
+	/// </summary>
+	/// <param name="drawNodes">Should Quadtree nodes be drawn?</param>
+	/// <param name="drawAABB">Should the object's AABB be drawn?</param>
+	void Draw(bool drawCollider = true, bool drawAABB = false, bool drawNodes = false);
+#endif // _DEBUG
+	
+#ifdef QUADTREE_STATS
+	/// <summary>
+	/// Measures the shape of the tree and reads the counters. Walks every node, so call it once a
+	/// frame at most, then ResetStats() to make the counters per frame.
+	/// </summary>
+	/// <returns>The snapshot.</returns>
+	QuadtreeStats GetStats() const;
+
+	/// <summary>
+	/// Zeros the branch, collapse and query counters.
+	/// </summary>
+	void ResetStats() noexcept;
+#endif // QUADTREE_STATS
+
+	/// <summary>
+	/// Counts Drawthe total number objects in the tree.
+	/// </summary>
+	/// <returns>the total number objects in the tree</returns>
+	unsigned GetTotalObjects() const noexcept;
+
+	/// <summary>
+	/// Sets how far below maxObjects a subtree has to shrink before its children are collapsed.
+	/// With 0 (the default) a node collapses as soon as it could hold everything below it, which
+	/// can make a node branch and collapse over and over when its count hovers around maxObjects.
+	/// </summary>
+	/// <param name="hysteresis">The number of objects below maxObjects needed to collapse.</param>
+	void SetCollapseHysteresis(unsigned hysteresis) noexcept;
+
+	/// <summary>
+	/// Turns the tree into a loose quadtree. Each child's area is grown around its center by this
+	/// factor, and an object goes to the child that holds its center as long as it fits inside that
+	/// child's loose area. Objects that straddle a center line no longer pile up in the parent, at
+	/// the cost of searching any child whose loose area reaches the query.
+	/// 1 (the default) is a normal quadtree, 2 is the usual loose quadtree. Re-inserts every object.
+	/// </summary>
+	/// <param name="looseness">The factor to grow each child by. Clamped to at least 1.</param>
+	void SetLooseness(float looseness);
+
+	/// <summary>
+	/// Gets the looseness factor.
+	/// </summary>
+	/// <returns>The factor each child's area is grown by. 1 if the tree is not loose.</returns>
+	float GetLooseness() const noexcept;
+
+	/// <summary>
+	/// Sets whether the tree grows to fit objects that are inserted or moved outside its bounds.
+	/// Each time it grows, a new root twice the size is placed around the old one, on the side the
+	/// object is on, and the old root becomes one of its children, so nothing already in the tree
+	/// has to move. The maximum depth goes up by one each time so the smallest nodes keep their size.
+	/// Growing adds at most 32 levels until the next Clear() or Resize(), and an object that can't
+	/// be reached within that is stored as if auto grow was off. On by default. When off, objects outside the bounds are kept in the nodes on the edge of the tree.
+	/// </summary>
+	/// <param name="autoGrow">Should the tree grow?</param>
+	void SetAutoGrow(bool autoGrow) noexcept;
+
+	/// <summary>
+	/// Gets whether the tree grows to fit objects outside its bounds.
+	/// </summary>
+	/// <returns>true if the tree grows.</returns>
+	bool GetAutoGrow() const noexcept;
+
+	/// <summary>
+	/// Stores each object with a fat AABB, its AABB grown by a margin on every side, instead of
+	/// its exact AABB. Update() leaves the tree alone while the AABB stays inside the fat AABB, so
+	/// objects that jitter in place stop moving between nodes. Queries and pairs test the fat
+	/// AABBs, so they can return objects whose real AABBs are up to twice the margin apart.
+	/// 0 (the default) stores exact AABBs. Takes effect as objects are inserted or leave their fat AABB.
+	/// </summary>
+	/// <param name="margin">How far each side is pushed out. Clamped to at least 0.</param>
+	void SetFatMargin(float margin) noexcept;
+
+	/// <summary>
+	/// Gets how far each side of an object's AABB is pushed out to make its fat AABB.
+	/// </summary>
+	/// <returns>The margin. 0 if exact AABBs are stored.</returns>
+	float GetFatMargin() const noexcept;
+
+	/// <summary>
+	/// Sets how many frames ahead a fat AABB is stretched along the displacement passed to
+	/// Update(object, displacement). Fast objects then stay inside their fat AABB for a few frames.
+	/// 0 (the default) turns the stretch off.
+	/// </summary>
+	/// <param name="scale">The number of frames of movement to stretch by. Clamped to at least 0.</param>
+	void SetVelocityScale(float scale) noexcept;
+
+	/// <summary>
+	/// Gets how many frames ahead a fat AABB is stretched along an object's displacement.
+	/// </summary>
+	/// <returns>The scale. 0 if fat AABBs are not stretched.</returns>
+	float GetVelocityScale() const noexcept;
+
+	/// <summary>
+	/// A read only copy of the tree at one point in time.
+	/// </summary>
+	class Snapshot;
+
+	/// <summary>
+	/// Takes a read only copy of the tree as it is now, for example to rewind hit queries to an
+	/// earlier tick. The snapshot shares every node with the tree, so taking one is O(1). The next
+	/// change to a shared node copies the block holding it, which copies only the blocks on the path
+	/// from the root to the change. Must be called on the thread that changes the tree.
+	/// </summary>
+	/// <returns>A snapshot that keeps answering queries as the tree was when it was taken.</returns>
+	Snapshot TakeSnapshot() const;
+
+protected:
+
+	/// <summary>
+	/// Index used in place of a node that does not exist (no parent, no children).
+	/// </summary>
+	static constexpr unsigned NullNode = ~0u;
+
+	/// <summary>
+	/// Index of the root node. The root always occupies the first slot of the first block.
+	/// </summary>
+	static constexpr unsigned RootNode = 0;
+
+	/// <summary>
+	/// The objects stored in one Node. Bounds are kept in structure-of-arrays form next to a
+	/// parallel array of objects, so overlap tests run over packed floats and only touch a
+	/// object once it is known to be a hit. Order is not preserved.
+	/// </summary>
+	class Bucket
+	{
+	public:
+
+		/// <summary>
+		/// Gets the number of objects in the bucket.
+		/// </summary>
+		unsigned Size() const noexcept { return (unsigned)objects_.size(); }
+
+		/// <summary>
+		/// Is the bucket empty?
+		/// </summary>
+		bool Empty() const noexcept { return objects_.empty(); }
+
+		/// <summary>
+		/// Gets the object stored in a slot.
+		/// </summary>
+		T operator[](unsigned slot) const noexcept { return objects_[slot]; }
+
+		/// <summary>
+		/// Gets the bounds the object in a slot was stored with.
+		/// </summary>
+		AABB GetBounds(unsigned slot) const noexcept { return AABB(minX_[slot], minY_[slot], maxX_[slot], maxY_[slot]); }
+
+		/// <summary>
+		/// Gets the layers of the object in a slot.
+		/// </summary>
+		LayerMask GetLayers(unsigned slot) const noexcept { return layers_[slot]; }
+
+		/// <summary>
+		/// Gets every layer that an object in the bucket is on.
+		/// </summary>
+		LayerMask GetLayerUnion() const noexcept { return layerUnion_; }
+
+		/// <summary>
+		/// Replaces the layers of the object in a slot.
+		/// </summary>
+		/// <param name="slot">The slot to change.</param>
+		/// <param name="layers">The new layers.</param>
+		void SetLayers(unsigned slot, LayerMask layers) noexcept;
+
+		/// <summary>
+		/// Replaces the bounds stored for the object in a slot.
+		/// </summary>
+		/// <param name="slot">The slot to change.</param>
+		/// <param name="bounds">The new bounds.</param>
+		void SetBounds(unsigned slot, const AABB& bounds) noexcept;
+
+		/// <summary>
+		/// Adds an object to the end of the bucket.
+		/// </summary>
+		/// <param name="object">The object to add.</param>
+		/// <param name="bounds">The bounds to store for the object.</param>
+		/// <param name="layers">The layers the object is on.</param>
+		void Add(T object, const AABB& bounds, LayerMask layers);
+
+		/// <summary>
+		/// Removes the object in a slot by moving the last object into its place.
+		/// </summary>
+		/// <param name="slot">The slot to remove.</param>
+		void RemoveAt(unsigned slot) noexcept;
+
+		/// <summary>
+		/// Moves every object from another bucket into this one.
+		/// </summary>
+		/// <param name="other">The bucket to empty.</param>
+		void TakeAll(Bucket& other);
+
+		/// <summary>
+		/// Copies every object from another bucket to the end of this one.
+		/// </summary>
+		/// <param name="other">The bucket to copy from.</param>
+		void Append(const Bucket& other);
+
+		/// <summary>
+		/// Removes objects from the end of the bucket until it holds a certain number.
+		/// </summary>
+		/// <param name="size">The number of objects to keep.</param>
+		void Truncate(unsigned size) noexcept;
+
+		/// <summary>
+		/// Removes every object. Capacity is kept so the bucket can be refilled without allocating.
+		/// </summary>
+		void Clear() noexcept;
+
+		/// <summary>
+		/// Calls a visitor with the slot of every object whose stored bounds overlap an area.
+		/// </summary>
+		/// <param name="area">The area to test against.</param>
+		/// <param name="first">The first slot to test. Earlier slots are skipped.</param>
+		/// <param name="visitor">Called as visitor(unsigned slot) for each overlap. May return false to stop.</param>
+		/// <returns>false if the visitor stopped early.</returns>
+		template<typename Visitor>
+		bool ForEachOverlap(const AABB& area, unsigned first, Visitor&& visitor) const;
+
+		/// <summary>
+		/// Calls a visitor with the slot of every object on the given layers whose stored bounds overlap
+		/// an area. Returns straight away if no object in the bucket is on those layers.
+		/// </summary>
+		/// <param name="area">The area to test against.</param>
+		/// <param name="first">The first slot to test. Earlier slots are skipped.</param>
+		/// <param name="mask">The layers to find objects on.</param>
+		/// <param name="visitor">Called as visitor(unsigned slot) for each overlap. May return false to stop.</param>
+		/// <returns>false if the visitor stopped early.</returns>
+		template<typename Visitor>
+		bool ForEachOverlap(const AABB& area, unsigned first, LayerMask mask, Visitor&& visitor) const;
+
+	private:
+
+		/// <summary>
+		/// Recomputes layerUnion_ after an object left the bucket or changed layers.
+		/// </summary>
+		void RefreshLayerUnion() noexcept;
+
+		/// <summary>
+		/// The packed bounds of the objects, one entry per slot.
+		/// </summary>
+		std::vector<float> minX_;
+		std::vector<float> minY_;
+		std::vector<float> maxX_;
+		std::vector<float> maxY_;
+
+		/// <summary>
+		/// The objects, one entry per slot.
+		/// </summary>
+		std::vector<T> objects_;
+
+		/// <summary>
+		/// The layers of the objects, one entry per slot.
+		/// </summary>
+		std::vector<LayerMask> layers_;
+
+		/// <summary>
+		/// Every layer that an object in the bucket is on.
+		/// </summary>
+		LayerMask layerUnion_ = 0;
+	};
+
+	/// <summary>
+	/// A Node is a single division of a Quadtree.
+	/// The Quadtree starts with one root node, and each node has 4 children.
+	/// Nodes live in the tree's NodePool and refer to each other by index.
+	/// </summary>
+	class Node
+	{
+	public:
+		/// <summary>
+		/// Default constructor. Only used by the NodePool to fill unused slots.
+		/// </summary>
+		Node() noexcept = default;
+
+		/// <summary>
+		/// Non-default constructor.
+		/// </summary>
+		/// <param name="index">The index of this node in the tree's NodePool.</param>
+		/// <param name="depth">The depth of the node. 0 is root.</param>
+		/// <param name="bounds">The size of the node.</param>
+		/// <param name="parent">The index of the parent node. If NullNode, the node is a root.</param>
+		/// <returns>A new Node.</returns>
+		Node(unsigned index, unsigned depth, AABB bounds, unsigned parent) noexcept : index_(index), depth_(depth), bounds_(bounds), parent_(parent) {}
+		
+		/// <summary>
+		/// Inserts an object into the Quadtree using bounds that have already been read.
+		/// Nodes do not point back at their tree, so every function that needs it is handed the
+		/// tree. Moving or swapping a tree then never has to touch its nodes.
+		/// </summary>
+		/// <param name="tree">The tree that owns this node.</param>
+		/// <param name="object">The object to insert.</param>
+		/// <param name="bounds">The bounds of the object.</param>
+		/// <param name="layers">The layers the object is on.</param>
+		/// <returns>true if the object was inserted successfully, false otherwise.</returns>
+		bool Insert(BasicQuadtree& tree, T object, const AABB& bounds, LayerMask layers = AllLayers);
+
+		/// <summary>
+		/// Removes the object in one of this node's slots from the tree.
+		/// </summary>
+		/// <param name="tree">The tree that owns this node.</param>
+		/// <param name="slot">The slot of the object in this node.</param>
+		void Remove(BasicQuadtree& tree, unsigned slot);
+
+		/// <summary>
+		/// Moves the object in one of this node's slots to match new bounds.
+		/// Helper function for Quadtree::Update().
+		/// </summary>
+		/// <param name="tree">The tree that owns this node.</param>
+		/// <param name="slot">The slot of the object in this node.</param>
+		/// <param name="newBounds">The new bounds of the object.</param>
+		/// <returns>true if the object was updated.</returns>
+		bool Update(BasicQuadtree& tree, unsigned slot, _In_ const AABB& newBounds);
+
+		/// <summary>
+		/// Gets the bounds.
+		/// </summary>
+		/// <returns>A constant AABB reference to the bounds of the node.</returns>
+		const AABB& GetBounds() const noexcept;
+
+		/// <summary>
+		/// Sets the bounds.
+		/// </summary>
+		/// <param name="aabb">The new bounds for the node.</param>
+		/// <returns></returns>
+		void SetBounds(const AABB& aabb) noexcept;
+
+		/// <summary>
+		/// Recursively clears a node of all objects and children underneath it.
+		/// </summary>
+		/// <param name="tree">The tree that owns this node.</param>
+		void Clear(BasicQuadtree& tree);
+
+	private:
+
+		friend class BasicQuadtree;
+		friend class NodePool;
+		friend class Snapshot;
+
+		/// <summary>
+		/// Does this node have children?
+		/// </summary>
+		/// <returns>true if the node has been branched, false if it is a leaf.</returns>
+		bool HasChildren() const noexcept { return firstChild_ != NullNode; }
+
+		/// <summary>
+		/// Gets one of the children of this node to change it. Only valid if HasChildren() is true.
+		/// </summary>
+		/// <param name="tree">The tree that owns this node.</param>
+		/// <param name="quadrant">0 = north west, 1 = north east, 2 = south west, 3 = south east.</param>
+		/// <returns>A reference to the child node.</returns>
+		Node& Child(BasicQuadtree& tree, unsigned quadrant);
+
+		/// <summary>
+		/// Gets one of the children of this node. Only valid if HasChildren() is true.
+		/// </summary>
+		/// <param name="tree">The tree that owns this node.</param>
+		/// <param name="quadrant">0 = north west, 1 = north east, 2 = south west, 3 = south east.</param>
+		/// <returns>A constant reference to the child node.</returns>
+		const Node& Child(const BasicQuadtree& tree, unsigned quadrant) const noexcept;
+
+		/// <summary>
+		/// Gets the parent of this node to change it. Only valid if this node is not the root.
+		/// </summary>
+		/// <param name="tree">The tree that owns this node.</param>
+		/// <returns>A reference to the parent node.</returns>
+		Node& Parent(BasicQuadtree& tree);
+
+		/// <summary>
+		/// Calls a visitor with this node and every node below it that could hold objects overlapping an area.
+		/// Subtrees with no objects on the given layers are skipped, which includes empty subtrees.
+		/// </summary>
+		/// <param name="tree">The tree that owns this node.</param>
+		/// <param name="area">The area to search.</param>
+		/// <param name="mask">The layers to find objects on.</param>
+		/// <param name="visitor">Called as visitor(const Node&) for each node. May return false to stop.</param>
+		/// <returns>false if the visitor stopped early.</returns>
+		template<typename Visitor>
+		bool VisitNodes(const BasicQuadtree& tree, const AABB& area, LayerMask mask, Visitor&& visitor) const;
+
+		/// <summary>
+		/// Calls VisitNodes() for every layer.
+		/// </summary>
+		template<typename Visitor>
+		bool VisitNodes(const BasicQuadtree& tree, const AABB& area, Visitor&& visitor) const { return VisitNodes(tree, area, AllLayers, std::forward<Visitor>(visitor)); }
+
+		/// <summary>
+		/// Recomputes the layers of this node and its ancestors after an object left or changed
+		/// layers, stopping at the first node whose layers did not change.
+		/// </summary>
+		/// <param name="tree">The tree that owns this node.</param>
+		void RefreshLayers(BasicQuadtree& tree);
+
+		/// <summary>
+		/// Tests a segment against the objects in this node, then the children front to back.
+		/// Helper function for Quadtree::RayCast().
+		/// </summary>
+		/// <param name="tree">The tree that owns this node.</param>
+		/// <param name="start">The start of the segment.</param>
+		/// <param name="delta">The end of the segment minus the start.</param>
+		/// <param name="hit">The closest hit so far. Updated.</param>
+		/// <param name="found">Has anything been hit so far? Updated.</param>
+		void RayCast(const BasicQuadtree& tree, const DirectX::SimpleMath::Vector2& start, const DirectX::SimpleMath::Vector2& delta, _Inout_ RayHit& hit, _Inout_ bool& found) const noexcept;
+
+		/// <summary>
+		/// Pairs the objects in this node with each other and with every object stored above it,
+		/// then recurses into the children. Helper function for FindAllPairs.
+		/// </summary>
+		/// <param name="tree">The tree that owns this node.</param>
+		/// <param name="ancestors">The objects stored in the nodes above this one. Restored before returning.</param>
+		/// <param name="pairs">The vector the overlapping pairs are appended to.</param>
+		void FindAllPairs(const BasicQuadtree& tree, _Inout_ Bucket& ancestors, _Inout_ std::vector<ObjectPair>& pairs) const;
+
+		/// <summary>
+		/// Pairs every object in this subtree with every overlapping object in another subtree.
+		/// Used by FindAllPairs on loose trees, where sibling subtrees overlap.
+		/// </summary>
+		/// <param name="tree">The tree that owns this node.</param>
+		/// <param name="other">A node that is neither an ancestor nor a descendant of this one.</param>
+		/// <param name="pairs">The vector the overlapping pairs are appended to.</param>
+		void FindPairsAcross(const BasicQuadtree& tree, const Node& other, _Inout_ std::vector<ObjectPair>& pairs) const;
+
+		/// <summary>
+		/// Pairs one object with every overlapping object in this subtree.
+		/// </summary>
+		/// <param name="tree">The tree that owns this node.</param>
+		/// <param name="object">The object to pair.</param>
+		/// <param name="bounds">The stored bounds of the object.</param>
+		/// <param name="pairs">The vector the overlapping pairs are appended to.</param>
+		void FindPairsWith(const BasicQuadtree& tree, T object, const AABB& bounds, _Inout_ std::vector<ObjectPair>& pairs) const;
+		
+		/// <summary>
+		/// Allocates a block of 4 children from the pool and pushes objects down into them.
+		/// </summary>
+		/// <param name="tree">The tree that owns this node.</param>
+		void Branch(BasicQuadtree& tree);
+
+		/// <summary>
+		/// Allocates a block of 4 empty children from the pool. Helper function for Branch() and BuildFrom().
+		/// </summary>
+		/// <param name="tree">The tree that owns this node.</param>
+		void CreateChildren(BasicQuadtree& tree);
+		
+		/// <summary>
+		/// Moves every object stored below this node into this node and returns the children to the pool.
+		/// </summary>
+		/// <param name="tree">The tree that owns this node.</param>
+		void Collapse(BasicQuadtree& tree);
+
+		/// <summary>
+		/// Adds an object to this node's bucket and records where it was stored.
+		/// </summary>
+		/// <param name="tree">The tree that owns this node.</param>
+		/// <param name="object">The object to add.</param>
+		/// <param name="bounds">The bounds of the object.</param>
+		/// <param name="layers">The layers the object is on.</param>
+		void Store(BasicQuadtree& tree, T object, const AABB& bounds, LayerMask layers);
+
+		/// <summary>
+		/// Removes the object in a slot from this node's bucket and fixes the location of the
+		/// object that was moved into its place. The caller decides what happens to the object.
+		/// </summary>
+		/// <param name="tree">The tree that owns this node.</param>
+		/// <param name="slot">The slot to empty.</param>
+		void Unstore(BasicQuadtree& tree, unsigned slot);
+		
+		/// <summary>
+		/// Gets the total number of objects stored by this Node and its children.
+		/// The count is kept up to date by Store() and Unstore(), so this does not recurse.
+		/// </summary>
+		/// <returns>The count of objects</returns>
+		unsigned GetObjectCountInNode() const noexcept;
+
+		/// <summary>
+		/// Finds which child an object with a certain bounds belongs in.
+		/// </summary>
+		/// <param name="tree">The tree that owns this node.</param>
+		/// <param name="objectBounds">The bounds of the object.</param>
+		/// <returns>0 = north west, 1 = north east, 2 = south west, 3 = south east, -1 if it straddles the center.</returns>
+		int GetQuadrant(const BasicQuadtree& tree, _In_ const AABB& objectBounds) const noexcept;
+
+		/// <summary>
+		/// Gets the area this node covers grown by the tree's looseness factor.
+		/// Every object stored in or below a node is inside its loose bounds.
+		/// </summary>
+		/// <param name="tree">The tree that owns this node.</param>
+		/// <returns>The loose bounds.</returns>
+		AABB GetLooseBounds(const BasicQuadtree& tree) const noexcept;
+
+		/// <summary>
+		/// Gets an area that holds every object stored in or below this node. For a loose tree this
+		/// is the loose bounds. Otherwise it is the bounds, stretched to infinity on any side that is
+		/// on the edge of the tree, because objects outside the tree are routed to the edge nodes.
+		/// </summary>
+		/// <param name="tree">The tree that owns this node.</param>
+		/// <returns>The search bounds.</returns>
+		AABB GetSearchBounds(const BasicQuadtree& tree) const noexcept;
+
+		/// <summary>
+		/// Checks if this node's parent would send an object with a certain bounds down to this node.
+		/// Always true for the root.
+		/// </summary>
+		/// <param name="tree">The tree that owns this node.</param>
+		/// <param name="objectBounds">The bounds of the object.</param>
+		/// <returns>true if the parent routes the bounds here.</returns>
+		bool IsRouteFromParent(const BasicQuadtree& tree, _In_ const AABB& objectBounds) const noexcept;
+
+		/// <summary>
+		/// Searches below the node to find where an object with a certain bounds would be stored.
+		/// Branches the tree if needed.
+		/// Helper function for Insert().
+		/// </summary>
+		/// <param name="tree">The tree that owns this node.</param>
+		/// <param name="objectBounds">The bounds of the object to insert.</param>
+		/// <returns>A pointer to the Node that the object should be added to.</returns>
+		Node* GetNodeForInsertion(BasicQuadtree& tree, _In_ const AABB& objectBounds);
+		
+
+		/// <summary>
+		/// The index of this node in the tree's NodePool.
+		/// </summary>
+		unsigned index_ = NullNode;
+
+		/// <summary>
+		/// The depth of the node. 0 is root, 1 is first division, 2 is second, etc.
+		/// </summary>
+		unsigned depth_ = 0;
+		
+		/// <summary>
+		/// The area this node covers.
+		/// </summary>
+		AABB bounds_;
+		
+		/// <summary>
+		/// The index of the parent of this node.
+		/// </summary>
+		unsigned parent_ = NullNode;
+		
+		/// <summary>
+		/// The index of the first of this Node's 4 children. The siblings are stored contiguously.
+		/// </summary>
+		unsigned firstChild_ = NullNode;
+
+		/// <summary>
+		/// The number of objects stored in this Node and every Node below it.
+		/// </summary>
+		unsigned count_ = 0;
+
+		/// <summary>
+		/// Every layer that an object in this Node or any Node below it is on.
+		/// </summary>
+		LayerMask layers_ = 0;
+		
+		/// <summary>
+		/// The objects that are stored in this Node.
+		/// </summary>
+		Bucket objects_;
+	};
+
+	/// <summary>
+	/// An object being bulk loaded by BuildFrom(), with its bounds read once.
+	/// </summary>
+	struct BuildItem
+	{
+		T object;
+		AABB bounds;
+		int quadrant;
+		LayerMask layers = AllLayers;
+	};
+
+	/// <summary>
+	/// The kinds of change that can be queued for Commit().
+	/// </summary>
+	enum class CommandType : uint8_t
+	{
+		Insert,
+		Remove,
+		Update
+	};
+
+	/// <summary>
+	/// A change queued for Commit().
+	/// </summary>
+	struct Command
+	{
+		T object;
+		CommandType type;
+	};
+
+	/// <summary>
+	/// An object being inserted by Commit(), with the node its descent from the root ends at.
+	/// </summary>
+	struct QueuedInsert
+	{
+		T object;
+		AABB bounds;
+		unsigned node;
+	};
+
+	/// <summary>
+	/// Where an object is stored: the node it is in and its slot in that node's bucket.
+	/// </summary>
+	struct Location
+	{
+		unsigned node;
+		unsigned slot;
+	};
+
+	/// <summary>
+	/// Owns every Node in a Quadtree. Nodes are handed out in blocks of 4 siblings, and each block
+	/// is allocated on its own and listed in a fixed size page, so a node never moves while its block
+	/// is only used by one pool and freed blocks are recycled instead of being returned to the heap.
+	/// Pages and blocks are shared between copies of a pool and copied the first time a node in
+	/// them is changed, which is what makes snapshots O(1).
+	/// </summary>
+	class NodePool
+	{
+	public:
+
+		/// <summary>
+		/// Default constructor.
+		/// </summary>
+		/// <returns>A pool with no blocks.</returns>
+		NodePool();
+
+		~NodePool() = default;
+
+		/// <summary>
+		/// Copy constructor. Shares every page and block with the other pool, so it is O(1).
+		/// </summary>
+		NodePool(const NodePool&) = default;
+
+		/// <summary>
+		/// Copy assignment operator. Shares every page and block with the other pool.
+		/// </summary>
+		NodePool& operator=(const NodePool&) = default;
+
+		NodePool(NodePool&&) noexcept = default;
+		NodePool& operator=(NodePool&&) noexcept = default;
+
+		/// <summary>
+		/// Allocates a block of 4 contiguous nodes.
+		/// </summary>
+		/// <returns>The index of the first node in the block.</returns>
+		unsigned AllocateBlock();
+
+		/// <summary>
+		/// Returns a block of 4 nodes to the pool so it can be reused.
+		/// </summary>
+		/// <param name="firstNode">The index of the first node in the block.</param>
+		void FreeBlock(unsigned firstNode);
+
+		/// <summary>
+		/// Makes a pool that shares every node with this one, for reading. Unlike a copy, the free
+		/// blocks are not copied, so it is O(1) however many blocks have been freed.
+		/// </summary>
+		/// <returns>The shared pool.</returns>
+		NodePool Share() const noexcept;
+
+		/// <summary>
+		/// Gets a node by index so it can be changed. If the block holding the node is shared with
+		/// another pool, the block is copied first and the other pool keeps the original.
+		/// Only use this to write, reading through it copies blocks that never change.
+		/// </summary>
+		Node& operator[](unsigned index);
+
+		/// <summary>
+		/// Gets a node by index to read it. Never copies. Use std::as_const on a pool that is not
+		/// const to pick this one.
+		/// </summary>
+		const Node& operator[](unsigned index) const noexcept;
+
+	private:
+
+		/// <summary>
+		/// Number of sibling nodes handed out together.
+		/// </summary>
+		static constexpr unsigned BlockSize = 4;
+
+		/// <summary>
+		/// log2 of the number of nodes in a page.
+		/// </summary>
+		static constexpr unsigned PageShift = 8;
+		static constexpr unsigned PageSize = 1u << PageShift;
+		static constexpr unsigned PageMask = PageSize - 1;
+
+		/// <summary>
+		/// 4 sibling nodes, the unit that is copied when a shared node is changed.
+		/// </summary>
+		using Block = std::array<Node, BlockSize>;
+
+		/// <summary>
+		/// The blocks of PageSize nodes.
+		/// </summary>
+		using Page = std::array<std::shared_ptr<Block>, PageSize / BlockSize>;
+
+		/// <summary>
+		/// Every page of the pool.
+		/// </summary>
+		using PageTable = std::vector<std::shared_ptr<Page>>;
+
+		/// <summary>
+		/// Copies a page, block or the page table if another pool also uses it. The caller must
+		/// issue an acquire fence before writing to the part that is returned.
+		/// </summary>
+		/// <param name="shared">The pointer to the part being changed. Replaced by the copy.</param>
+		/// <returns>The part, which only this pool uses.</returns>
+		template<typename Part>
+		static Part& MakeUnique(std::shared_ptr<Part>& shared);
+
+		/// <summary>
+		/// The pages of nodes, shared with every snapshot taken since the table was last changed.
+		/// </summary>
+		std::shared_ptr<PageTable> pages_;
+
+		/// <summary>
+		/// Indices of blocks that were freed and can be reused.
+		/// </summary>
+		std::vector<unsigned> freeBlocks_;
+
+		/// <summary>
+		/// The number of nodes that have ever been handed out (the high water mark).
+		/// </summary>
+		unsigned used_ = 0;
+	};
+
+public:
+
+	/// <summary>
+	/// A read only copy of a BasicQuadtree, made by TakeSnapshot(). It shares its nodes with the
+	/// tree until the tree changes them, can be kept after the tree is destroyed and can be queried
+	/// from any thread. Copying a snapshot is O(1) as well.
+	/// </summary>
+	class Snapshot
+	{
+	public:
+
+		/// <summary>
+		/// Gets the area the tree covered when the snapshot was taken.
+		/// </summary>
+		/// <returns>The bounds of the root.</returns>
+		const AABB& GetBounds() const noexcept;
+
+		/// <summary>
+		/// Counts the objects that were in the tree when the snapshot was taken.
+		/// </summary>
+		/// <returns>The total number of objects.</returns>
+		unsigned GetTotalObjects() const noexcept;
+
+		/// <summary>
+		/// Finds every object whose stored AABB overlapped an area when the snapshot was taken.
+		/// </summary>
+		/// <param name="area">The area to search.</param>
+		/// <param name="results">The vector the objects are added to.</param>
+		void QueryRegion(const AABB& area, _Inout_ std::vector<T>& results) const;
+
+		/// <summary>
+		/// Finds every object on the given layers whose stored AABB overlapped an area when the snapshot was taken.
+		/// </summary>
+		/// <param name="area">The area to search.</param>
+		/// <param name="mask">The layers to find objects on.</param>
+		/// <param name="results">The vector the objects are added to.</param>
+		void QueryRegion(const AABB& area, LayerMask mask, _Inout_ std::vector<T>& results) const;
+
+		/// <summary>
+		/// Calls a visitor with every object whose stored AABB overlapped an area when the snapshot was taken.
+		/// </summary>
+		/// <param name="area">The area to search.</param>
+		/// <param name="visitor">Called as visitor(T) for each object. May return false to stop.</param>
+		/// <returns>false if the visitor stopped early.</returns>
+		template<typename Visitor> requires std::invocable<Visitor&, T>
+		bool QueryRegion(const AABB& area, Visitor&& visitor) const;
+
+		/// <summary>
+		/// Calls a visitor with every object on the given layers whose stored AABB overlapped an area
+		/// when the snapshot was taken.
+		/// </summary>
+		/// <param name="area">The area to search.</param>
+		/// <param name="mask">The layers to find objects on.</param>
+		/// <param name="visitor">Called as visitor(T) for each object. May return false to stop.</param>
+		/// <returns>false if the visitor stopped early.</returns>
+		template<typename Visitor> requires std::invocable<Visitor&, T>
+		bool QueryRegion(const AABB& area, LayerMask mask, Visitor&& visitor) const;
+
+		/// <summary>
+		/// Finds the first object a segment hit when the snapshot was taken.
+		/// </summary>
+		/// <param name="start">The start of the segment.</param>
+		/// <param name="end">The end of the segment.</param>
+		/// <param name="hit">Receives the object hit and how far along the segment it was.</param>
+		/// <returns>true if anything was hit.</returns>
+		bool RayCast(const DirectX::SimpleMath::Vector2& start, const DirectX::SimpleMath::Vector2& end, _Out_ RayHit& hit) const;
+
+	private:
+
+		friend class BasicQuadtree;
+
+		/// <summary>
+		/// Constructor used by TakeSnapshot().
+		/// </summary>
+		/// <param name="tree">The tree to share nodes with.</param>
+		explicit Snapshot(const BasicQuadtree& tree) noexcept;
+
+		/// <summary>
+		/// Calls a visitor with a node and every node below it that could hold objects on the given
+		/// layers overlapping an area. Works like Node::VisitNodes() but reads this snapshot's nodes.
+		/// </summary>
+		/// <param name="index">The node to start at.</param>
+		/// <param name="area">The area to search.</param>
+		/// <param name="mask">The layers to find objects on.</param>
+		/// <param name="visitor">Called as visitor(const Node&) for each node. May return false to stop.</param>
+		/// <returns>false if the visitor stopped early.</returns>
+		template<typename Visitor>
+		bool VisitNodes(unsigned index, const AABB& area, LayerMask mask, Visitor& visitor) const;
+
+		/// <summary>
+		/// Tests a segment against the objects in a node, then its children front to back.
+		/// Works like Node::RayCast() but reads this snapshot's nodes.
+		/// </summary>
+		/// <param name="index">The node to test.</param>
+		/// <param name="start">The start of the segment.</param>
+		/// <param name="delta">The end of the segment minus the start.</param>
+		/// <param name="hit">The closest hit so far. Updated.</param>
+		/// <param name="found">Has anything been hit so far? Updated.</param>
+		void RayCast(unsigned index, const DirectX::SimpleMath::Vector2& start, const DirectX::SimpleMath::Vector2& delta, _Inout_ RayHit& hit, _Inout_ bool& found) const noexcept;
+
+		/// <summary>
+		/// Gets the search bounds of a node. See Node::GetSearchBounds().
+		/// </summary>
+		AABB GetSearchBounds(const Node& node) const noexcept;
+
+		/// <summary>
+		/// The nodes, shared with the tree and other snapshots. Never changed, because the tree
+		/// copies a block before changing it.
+		/// </summary>
+		NodePool nodes_;
+
+		/// <summary>
+		/// The looseness of the tree when the snapshot was taken.
+		/// </summary>
+		float looseness_;
+
+		/// <summary>
+		/// The number of objects in the tree when the snapshot was taken.
+		/// </summary>
+		unsigned totalObjects_;
+	};
+
+
+private:
+
+	/// <summary>
+	/// Gets the root Node of the tree.
+	/// </summary>
+	Node& Root() noexcept { return nodes_[RootNode]; }
+
+	/// <summary>
+	/// Gets the root Node of the tree.
+	/// </summary>
+	const Node& Root() const noexcept { return nodes_[RootNode]; }
+
+	/// <summary>
+	/// Gets the current AABB of an item.
+	/// </summary>
+	AABB GetItemBounds(const T& object) const { return boundsFn_(object); }
+
+	/// <summary>
+	/// Calls a visitor that may or may not return a bool.
+	/// </summary>
+	/// <returns>What the visitor returned, or true if it returns nothing.</returns>
+	template<typename Visitor, typename... Args>
+	static bool Visit(Visitor& visitor, Args&&... args);
+
+	/// <summary>
+	/// Calls a visitor with every object on the given layers whose AABB overlaps an area, except one.
+	/// Only the objects passed to the visitor count as candidates in the stats.
+	/// Used by QueryRegion() and GetCollisionCandidates().
+	/// </summary>
+	/// <param name="area">The area to search.</param>
+	/// <param name="mask">The layers to find objects on.</param>
+	/// <param name="exclude">An object to skip, or null to skip none.</param>
+	/// <param name="visitor">Called as visitor(T) for each object. May return false to stop the search.</param>
+	/// <returns>false if the visitor stopped the search.</returns>
+	template<typename Visitor>
+	bool VisitOverlaps(const AABB& area, LayerMask mask, const T* exclude, Visitor&& visitor) const;
+
+	/// <summary>
+	/// Gets the squared distance from a point to the closest point of an AABB. 0 if the point is inside.
+	/// </summary>
+	static float DistanceSquared(const DirectX::SimpleMath::Vector2& point, const AABB& bounds) noexcept;
+
+	/// <summary>
+	/// Tests a segment against an AABB with the slab method.
+	/// </summary>
+	/// <param name="start">The start of the segment.</param>
+	/// <param name="delta">The end of the segment minus the start.</param>
+	/// <param name="bounds">The AABB to test.</param>
+	/// <param name="maxFraction">Hits further along the segment than this are ignored.</param>
+	/// <param name="fraction">Receives how far along the segment it enters the AABB. 0 if it starts inside.</param>
+	/// <returns>true if the segment hits the AABB.</returns>
+	static bool IntersectSegment(const DirectX::SimpleMath::Vector2& start, const DirectX::SimpleMath::Vector2& delta, const AABB& bounds, float maxFraction, _Out_ float& fraction) noexcept;
+
+	/// <summary>
+	/// Takes every object out of the tree and inserts it again with its stored bounds.
+	/// Used when a setting that changes where objects belong is changed.
+	/// </summary>
+	void Reinsert();
+
+	/// <summary>
+	/// Gets the subtree size at or below which a node's children are collapsed.
+	/// </summary>
+	unsigned GetCollapseThreshold() const noexcept;
+
+	/// <summary>
+	/// Collapses the highest node between a node and the root whose subtree has become small
+	/// enough. Only looks at the path to the root, so it costs O(depth).
+	/// Used by Remove() and Update().
+	/// </summary>
+	/// <param name="index">The node to start from.</param>
+	void CollapseUpward(unsigned index);
+
+	/// <summary>
+	/// Grows the area of a node by a looseness factor. See Node::GetLooseBounds().
+	/// </summary>
+	static AABB GetLooseBounds(const AABB& nodeBounds, float looseness) noexcept;
+
+	/// <summary>
+	/// Gets an area that holds every object stored in or below a node. See Node::GetSearchBounds().
+	/// </summary>
+	/// <param name="nodeBounds">The bounds of the node.</param>
+	/// <param name="rootBounds">The bounds of the root of its tree.</param>
+	/// <param name="looseness">The looseness of its tree.</param>
+	static AABB GetSearchBounds(const AABB& nodeBounds, const AABB& rootBounds, float looseness) noexcept;
+
+	/// <summary>
+	/// Makes the fat AABB stored for an object.
+	/// </summary>
+	/// <param name="bounds">The object's AABB.</param>
+	/// <param name="displacement">How far the object moved since the last update.</param>
+	/// <returns>bounds grown by the fat margin and stretched along the displacement.</returns>
+	AABB Fatten(const AABB& bounds, const DirectX::SimpleMath::Vector2& displacement) const noexcept;
+
+	/// <summary>
+	/// The most levels growing can add before the next Clear() or Resize(). Stops objects with huge
+	/// bounds from deepening the tree without limit.
+	/// </summary>
+	static constexpr unsigned MaxGrowDepth = 32;
+
+	/// <summary>
+	/// Grows the root until it holds an AABB, if auto grow is on. Does nothing if the AABB can't be
+	/// reached without going over MaxGrowDepth or growing the root past the largest float.
+	/// </summary>
+	/// <param name="bounds">The AABB that has to fit.</param>
+	void GrowToFit(const AABB& bounds);
+
+	/// <summary>
+	/// Works out the bounds the root would have after growing once.
+	/// </summary>
+	/// <param name="old">The root's bounds before growing.</param>
+	/// <param name="towards">The AABB to grow towards.</param>
+	/// <returns>old doubled in size on the side towards is on.</returns>
+	static AABB GetGrownBounds(const AABB& old, const AABB& towards) noexcept;
+
+	/// <summary>
+	/// Doubles the size of the root towards an AABB. The old root's contents become one of the new
+	/// root's children, and any object in them that the new root would not route there is inserted again.
+	/// </summary>
+	/// <param name="towards">The AABB to grow towards.</param>
+	void Grow(const AABB& towards);
+
+	/// <summary>
+	/// Every node of the tree. The root is always at RootNode.
+	/// </summary>
+	NodePool nodes_;
+
+	/// <summary>
+	/// The maximum depth of the tree.
+	/// </summary>
+	unsigned maxDepth_;
+
+	/// <summary>
+	/// The maximum number of objects allowed in a single node.
+	/// </summary>
+	unsigned maxObjects_;
+
+	/// <summary>
+	/// How far below maxObjects_ a subtree has to shrink before it is collapsed.
+	/// </summary>
+	unsigned collapseHysteresis_;
+
+	/// <summary>
+	/// How much each child's area is grown by in a loose quadtree. 1 if the tree is not loose.
+	/// </summary>
+	float looseness_;
+
+	/// <summary>
+	/// The total objects stored in the tree.
+	/// </summary>
+	unsigned totalObjects_;
+
+	/// <summary>
+	/// Is the tree in its read only phase?
+	/// </summary>
+	bool frozen_;
+
+	/// <summary>
+	/// Does the tree grow to fit objects outside its bounds?
+	/// </summary>
+	bool autoGrow_;
+
+	/// <summary>
+	/// How many levels growing has added to maxDepth_. Never more than MaxGrowDepth.
+	/// </summary>
+	unsigned grownDepth_;
+
+	/// <summary>
+	/// The maximum depth the tree was made with, before any growing.
+	/// </summary>
+	unsigned baseDepth_;
+
+	/// <summary>
+	/// The bounds the tree was made with or last resized to, before any growing.
+	/// </summary>
+	AABB baseBounds_;
+
+	/// <summary>
+	/// How far each side of an object's AABB is pushed out before it is stored.
+	/// </summary>
+	float fatMargin_;
+
+	/// <summary>
+	/// How many frames of displacement a fat AABB is stretched by.
+	/// </summary>
+	float velocityScale_;
+
+	/// <summary>
+	/// The location of every object in the tree, so Remove and Update never have to search for it.
+	/// </summary>
+	std::unordered_map<T, Location> locations_;
+
+	/// <summary>
+	/// Reads the AABB of an item.
+	/// </summary>
+	[[no_unique_address]] BoundsFn boundsFn_;
+
+	/// <summary>
+	/// Scratch bucket used by FindAllPairs to hold the objects of the nodes above the current one.
+	/// Kept between calls so the traversal does not allocate once it has warmed up.
+	/// </summary>
+	Bucket pairScratch_;
+
+	/// <summary>
+	/// Changes waiting for Commit().
+	/// </summary>
+	std::vector<Command> commands_;
+
+	/// <summary>
+	/// Is Commit() running? Collapses wait until it finishes.
+	/// </summary>
+	bool deferCollapse_;
+
+	/// <summary>
+	/// Scratch space for Commit(), kept between calls so committing does not allocate once it has
+	/// warmed up: whether each queued object ends up in the tree, the objects in the order they
+	/// were first queued, the inserts to apply, and the nodes whose collapse was put off.
+	/// </summary>
+	std::unordered_map<T, bool> commitStates_;
+	std::vector<T> commitOrder_;
+	std::vector<QueuedInsert> commitInserts_;
+	std::vector<unsigned> deferredCollapses_;
+
+#ifdef QUADTREE_STATS
+	/// <summary>
+	/// The work done by one search, added to the counters once it finishes.
+	/// </summary>
+	struct QueryCost
+	{
+		uint64_t nodes = 0;
+		uint64_t tests = 0;
+		uint64_t candidates = 0;
+	};
+
+	/// <summary>
+	/// Counters behind GetStats(). Queries can run on several threads at once, so they are atomic.
+	/// A copy of the tree starts with its own counters at zero.
+	/// </summary>
+	struct StatCounters
+	{
+		StatCounters() noexcept = default;
+		StatCounters(const StatCounters&) noexcept {}
+		StatCounters& operator=(const StatCounters&) noexcept { return *this; }
+
+		void Record(const QueryCost& cost) noexcept
+		{
+			queries.fetch_add(1, std::memory_order_relaxed);
+			nodesVisited.fetch_add(cost.nodes, std::memory_order_relaxed);
+			overlapTests.fetch_add(cost.tests, std::memory_order_relaxed);
+			candidates.fetch_add(cost.candidates, std::memory_order_relaxed);
+		}
+
+		std::atomic<uint64_t> branches = 0;
+		std::atomic<uint64_t> collapses = 0;
+		std::atomic<uint64_t> queries = 0;
+		std::atomic<uint64_t> nodesVisited = 0;
+		std::atomic<uint64_t> overlapTests = 0;
+		std::atomic<uint64_t> candidates = 0;
+	};
+
+	/// <summary>
+	/// Counts branches, collapses and the cost of queries.
+	/// </summary>
+	mutable StatCounters stats_;
+#endif // QUADTREE_STATS
+
+};
+
+#include "BasicQuadtree.inl"
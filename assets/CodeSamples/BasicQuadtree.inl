@@ -0,0 +1,2016 @@
+﻿#pragma once
+/*******************************************************************************
+
+	@file BasicQuadtree.inl
+
+	@date 10/17/2026 4:12:37 PM
+
+	@authors
+	Christian Wookey (christian.wookey@digipen.edu)
+
+	@brief
+	Quadtree over any item type, used to reduce the number of collision checks.
+
+	@copyright All content © copyright 2020-2021, DigiPen (USA) Corporation 
+
+*******************************************************************************/
+
+/*****************************************************************************/
+/*								TREE IMPLEMENTATION		                     */
+/*****************************************************************************/
+/*****************************************************************************/
+/*                             PUBLIC FUNCTIONS                              */
+/*****************************************************************************/
+template<typename T, typename BoundsFn>
+BasicQuadtree<T, BoundsFn>::BasicQuadtree(unsigned maxLevels, unsigned maxObjects, AABB bounds, BoundsFn boundsFn) : maxDepth_(maxLevels), maxObjects_(maxObjects), collapseHysteresis_(0), looseness_(1.f), totalObjects_(0), frozen_(false), autoGrow_(true), grownDepth_(0), baseDepth_(maxLevels), baseBounds_(bounds), fatMargin_(0.f), velocityScale_(0.f), boundsFn_(std::move(boundsFn)), deferCollapse_(false)
+{
+	const unsigned root = nodes_.AllocateBlock();
+	nodes_[root] = Node(root, 0, bounds, NullNode);
+}
+
+template<typename T, typename BoundsFn>
+BasicQuadtree<T, BoundsFn>::BasicQuadtree(const BasicQuadtree& other) : nodes_(other.nodes_), maxDepth_(other.maxDepth_), maxObjects_(other.maxObjects_), collapseHysteresis_(other.collapseHysteresis_), looseness_(other.looseness_), totalObjects_(other.totalObjects_), frozen_(other.frozen_), autoGrow_(other.autoGrow_), grownDepth_(other.grownDepth_), baseDepth_(other.baseDepth_), baseBounds_(other.baseBounds_), fatMargin_(other.fatMargin_), velocityScale_(other.velocityScale_), locations_(other.locations_), boundsFn_(other.boundsFn_), commands_(other.commands_), deferCollapse_(false)
+{
+}
+
+template<typename T, typename BoundsFn>
+BasicQuadtree<T, BoundsFn>& BasicQuadtree<T, BoundsFn>::operator=(const BasicQuadtree& other)
+{
+	if (this != &other)
+	{
+		nodes_ = other.nodes_;
+		maxDepth_ = other.maxDepth_;
+		maxObjects_ = other.maxObjects_;
+		collapseHysteresis_ = other.collapseHysteresis_;
+		looseness_ = other.looseness_;
+		totalObjects_ = other.totalObjects_;
+		frozen_ = other.frozen_;
+		autoGrow_ = other.autoGrow_;
+		grownDepth_ = other.grownDepth_;
+		baseDepth_ = other.baseDepth_;
+		baseBounds_ = other.baseBounds_;
+		fatMargin_ = other.fatMargin_;
+		velocityScale_ = other.velocityScale_;
+		locations_ = other.locations_;
+		boundsFn_ = other.boundsFn_;
+		commands_ = other.commands_;
+	}
+	return *this;
+}
+
+template<typename T, typename BoundsFn>
+BasicQuadtree<T, BoundsFn>::BasicQuadtree(BasicQuadtree&& other) : nodes_(std::move(other.nodes_)), maxDepth_(other.maxDepth_), maxObjects_(other.maxObjects_), collapseHysteresis_(other.collapseHysteresis_), looseness_(other.looseness_), totalObjects_(other.totalObjects_), frozen_(other.frozen_), autoGrow_(other.autoGrow_), grownDepth_(other.grownDepth_), baseDepth_(other.baseDepth_), baseBounds_(other.baseBounds_), fatMargin_(other.fatMargin_), velocityScale_(other.velocityScale_), locations_(std::move(other.locations_)), boundsFn_(std::move(other.boundsFn_)), pairScratch_(std::move(other.pairScratch_)), commands_(std::move(other.commands_)), deferCollapse_(false)
+{
+	// the other tree is left empty at the size it was made with, so it can still be used
+	other.nodes_ = NodePool();
+	const unsigned root = other.nodes_.AllocateBlock();
+	other.nodes_[root] = Node(root, 0, other.baseBounds_, NullNode);
+	other.maxDepth_ = other.baseDepth_;
+	other.grownDepth_ = 0;
+	other.totalObjects_ = 0;
+	other.locations_.clear();
+	other.pairScratch_.Clear();
+	other.commands_.clear();
+}
+
+template<typename T, typename BoundsFn>
+BasicQuadtree<T, BoundsFn>& BasicQuadtree<T, BoundsFn>::operator=(BasicQuadtree&& other) noexcept
+{
+	if (this != &other)
+	{
+		Swap(other);
+	}
+	return *this;
+}
+
+template<typename T, typename BoundsFn>
+void BasicQuadtree<T, BoundsFn>::Swap(BasicQuadtree& other) noexcept
+{
+	using std::swap;
+	swap(nodes_, other.nodes_);
+	swap(maxDepth_, other.maxDepth_);
+	swap(maxObjects_, other.maxObjects_);
+	swap(collapseHysteresis_, other.collapseHysteresis_);
+	swap(looseness_, other.looseness_);
+	swap(totalObjects_, other.totalObjects_);
+	swap(frozen_, other.frozen_);
+	swap(autoGrow_, other.autoGrow_);
+	swap(grownDepth_, other.grownDepth_);
+	swap(baseDepth_, other.baseDepth_);
+	swap(baseBounds_, other.baseBounds_);
+	swap(fatMargin_, other.fatMargin_);
+	swap(velocityScale_, other.velocityScale_);
+	swap(locations_, other.locations_);
+	swap(boundsFn_, other.boundsFn_);
+	swap(pairScratch_, other.pairScratch_);
+	swap(commands_, other.commands_);
+}
+
+template<typename T, typename BoundsFn>
+bool BasicQuadtree<T, BoundsFn>::Insert(T object)
+{
+	return Insert(object, Fatten(GetItemBounds(object), DirectX::SimpleMath::Vector2()));
+}
+
+template<typename T, typename BoundsFn>
+bool BasicQuadtree<T, BoundsFn>::Insert(T object, const AABB& bounds)
+{
+	if (frozen_ || !IsFiniteAABB(bounds) || locations_.find(object) != locations_.end())
+		return false;
+
+	GrowToFit(bounds);
+	return Root().Insert(*this, object, bounds);
+}
+
+template<typename T, typename BoundsFn>
+bool BasicQuadtree<T, BoundsFn>::Remove(T object)
+{
+	if (frozen_)
+		return false;
+
+	auto location = locations_.find(object);
+	if (location == locations_.end())
+		return false;
+
+	nodes_[location->second.node].Remove(*this, location->second.slot);
+	return true;
+}
+
+template<typename T, typename BoundsFn>
+bool BasicQuadtree<T, BoundsFn>::SetLayers(T object, LayerMask layers)
+{
+	if (frozen_)
+		return false;
+
+	auto location = locations_.find(object);
+	if (location == locations_.end())
+		return false;
+
+	Node& node = nodes_[location->second.node];
+	node.objects_.SetLayers(location->second.slot, layers);
+	node.RefreshLayers(*this);
+	return true;
+}
+
+template<typename T, typename BoundsFn>
+typename BasicQuadtree<T, BoundsFn>::LayerMask BasicQuadtree<T, BoundsFn>::GetLayers(T object) const
+{
+	auto location = locations_.find(object);
+	if (location == locations_.end())
+		return 0;
+
+	return nodes_[location->second.node].objects_.GetLayers(location->second.slot);
+}
+
+template<typename T, typename BoundsFn>
+void BasicQuadtree<T, BoundsFn>::QueueInsert(T object)
+{
+	commands_.push_back(Command{ object, CommandType::Insert });
+}
+
+template<typename T, typename BoundsFn>
+void BasicQuadtree<T, BoundsFn>::QueueRemove(T object)
+{
+	commands_.push_back(Command{ object, CommandType::Remove });
+}
+
+template<typename T, typename BoundsFn>
+void BasicQuadtree<T, BoundsFn>::QueueUpdate(T object)
+{
+	commands_.push_back(Command{ object, CommandType::Update });
+}
+
+template<typename T, typename BoundsFn>
+bool BasicQuadtree<T, BoundsFn>::Commit()
+{
+	if (frozen_)
+		return false;
+
+	// replay the commands against whether each object is in the tree, so every object ends up
+	// with one action no matter how many times it was queued
+	commitStates_.clear();
+	commitOrder_.clear();
+	for (const Command& command : commands_)
+	{
+		auto [state, added] = commitStates_.try_emplace(command.object, locations_.find(command.object) != locations_.end());
+		if (added)
+			commitOrder_.push_back(command.object);
+
+		if (command.type == CommandType::Insert)
+			state->second = true;
+		else if (command.type == CommandType::Remove)
+			state->second = false;
+	}
+	commands_.clear();
+
+	deferCollapse_ = true;
+	deferredCollapses_.clear();
+
+	// removes first, so inserts can reuse the room they leave instead of branching
+	for (T object : commitOrder_)
+	{
+		if (!commitStates_[object])
+			Remove(object);
+	}
+
+	commitInserts_.clear();
+	for (T object : commitOrder_)
+	{
+		if (!commitStates_[object])
+			continue;
+
+		if (locations_.find(object) != locations_.end())
+		{
+			Update(object);
+		}
+		else
+		{
+			const AABB bounds = Fatten(GetItemBounds(object), DirectX::SimpleMath::Vector2());
+			if (!IsFiniteAABB(bounds))
+				continue;
+
+			GrowToFit(bounds);
+			commitInserts_.push_back(QueuedInsert{ object, bounds, 0 });
+		}
+	}
+
+	// growing is done and nothing collapses until the end, so the nodes found here stay valid.
+	// Objects bound for the same node go in together, and each one only descends from where its
+	// search ended if that node branches while they are added.
+	for (QueuedInsert& insert : commitInserts_)
+	{
+		insert.node = Root().GetNodeForInsertion(*this, insert.bounds)->index_;
+	}
+	std::sort(commitInserts_.begin(), commitInserts_.end(), [](const QueuedInsert& a, const QueuedInsert& b) { return a.node < b.node; });
+	for (const QueuedInsert& insert : commitInserts_)
+	{
+		nodes_[insert.node].Insert(*this, insert.object, insert.bounds);
+	}
+
+	// only the paths above the nodes that lost objects can have become small enough. Nothing is
+	// allocated while collapsing, so a node freed by an earlier collapse still leads to the root.
+	deferCollapse_ = false;
+	std::sort(deferredCollapses_.begin(), deferredCollapses_.end());
+	deferredCollapses_.erase(std::unique(deferredCollapses_.begin(), deferredCollapses_.end()), deferredCollapses_.end());
+	for (unsigned node : deferredCollapses_)
+	{
+		CollapseUpward(node);
+	}
+	return true;
+}
+
+template<typename T, typename BoundsFn>
+size_t BasicQuadtree<T, BoundsFn>::GetQueuedCommandCount() const noexcept
+{
+	return commands_.size();
+}
+
+template<typename T, typename BoundsFn>
+void BasicQuadtree<T, BoundsFn>::Clear()
+{
+	if (frozen_)
+		return;
+
+	Root().Clear(*this);
+	locations_.clear();
+
+	// nothing is left outside the bounds the tree was given, so growing starts over
+	if (grownDepth_ > 0)
+	{
+		Root().SetBounds(baseBounds_);
+		maxDepth_ = baseDepth_;
+		grownDepth_ = 0;
+	}
+}
+
+template<typename T, typename BoundsFn>
+void BasicQuadtree<T, BoundsFn>::Resize(const AABB& newBounds)
+{
+	if (frozen_)
+		return;
+
+	baseBounds_ = newBounds;
+	maxDepth_ = baseDepth_;
+	grownDepth_ = 0;
+	Root().SetBounds(newBounds);
+	Reinsert();
+}
+
+template<typename T, typename BoundsFn>
+void BasicQuadtree<T, BoundsFn>::GetCollisionCandidates(T object, _Inout_ std::vector<T>& collisionCandidates) const noexcept
+{
+	GetCollisionCandidates(object, [&](T other) { collisionCandidates.push_back(other); });
+}
+
+template<typename T, typename BoundsFn>
+void BasicQuadtree<T, BoundsFn>::GetCollisionCandidates(T object, LayerMask mask, _Inout_ std::vector<T>& collisionCandidates) const
+{
+	GetCollisionCandidates(object, mask, [&](T other) { collisionCandidates.push_back(other); });
+}
+
+template<typename T, typename BoundsFn>
+bool BasicQuadtree<T, BoundsFn>::Update(T object)
+{
+	return Update(object, DirectX::SimpleMath::Vector2());
+}
+
+template<typename T, typename BoundsFn>
+bool BasicQuadtree<T, BoundsFn>::Update(T object, const DirectX::SimpleMath::Vector2& displacement)
+{
+	if (frozen_)
+		return false;
+
+	auto location = locations_.find(object);
+	if (location == locations_.end())
+		return false;
+
+	// an object still inside its fat AABB is left where it is
+	const AABB bounds = GetItemBounds(object);
+	if ((fatMargin_ > 0.f || velocityScale_ > 0.f) && ContainsAABB(std::as_const(nodes_)[location->second.node].objects_.GetBounds(location->second.slot), bounds))
+		return true;
+
+	return UpdateBounds(object, Fatten(bounds, displacement));
+}
+
+template<typename T, typename BoundsFn>
+bool BasicQuadtree<T, BoundsFn>::UpdateBounds(T object, const AABB& bounds)
+{
+	if (frozen_ || !IsFiniteAABB(bounds))
+		return false;
+
+	auto location = locations_.find(object);
+	if (location == locations_.end())
+		return false;
+
+	// growing can move the object's node, so the location is looked up again afterwards
+	if (autoGrow_ && !ContainsAABB(GetBounds(), bounds))
+	{
+		GrowToFit(bounds);
+		location = locations_.find(object);
+	}
+
+	return nodes_[location->second.node].Update(*this, location->second.slot, bounds);
+}
+
+template<typename T, typename BoundsFn>
+bool BasicQuadtree<T, BoundsFn>::GetCollisionCandidatesParallel(std::span<const T> objects, _Inout_ std::vector<std::vector<ObjectPair>>& results, unsigned threadCount) const
+{
+	if (!frozen_)
+		return false;
+
+	if (threadCount == 0)
+		threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+	// objects are handed out in small chunks from a shared counter, so a thread that lands on a
+	// crowded area does not hold up the others
+	constexpr size_t ChunkSize = 64;
+	const size_t chunkCount = (objects.size() + ChunkSize - 1) / ChunkSize;
+	threadCount = (unsigned)std::min<size_t>(threadCount, std::max<size_t>(chunkCount, 1));
+
+	results.resize(threadCount);
+	std::atomic<size_t> nextChunk = 0;
+
+	auto worker = [&](unsigned thread)
+	{
+		std::vector<ObjectPair>& pairs = results[thread];
+		pairs.clear();
+
+		for (size_t chunk = nextChunk++; chunk < chunkCount; chunk = nextChunk++)
+		{
+			const size_t end = std::min(objects.size(), (chunk + 1) * ChunkSize);
+			for (size_t i = chunk * ChunkSize; i < end; ++i)
+			{
+				GetCollisionCandidates(objects[i], [&](T candidate) { pairs.emplace_back(objects[i], candidate); });
+			}
+		}
+	};
+
+	std::vector<std::thread> threads;
+	threads.reserve(threadCount - 1);
+	for (unsigned thread = 1; thread < threadCount; ++thread)
+	{
+		threads.emplace_back(worker, thread);
+	}
+
+	// the calling thread does its share of the work instead of waiting
+	worker(0);
+
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+
+	return true;
+}
+
+template<typename T, typename BoundsFn>
+bool BasicQuadtree<T, BoundsFn>::BuildFrom(std::span<const T> objects)
+{
+	if (frozen_)
+		return false;
+
+	Clear();
+
+	// bounds are read once up front, after that only the packed copies are touched
+	std::vector<BuildItem> items(objects.size());
+	std::transform(std::execution::par, objects.begin(), objects.end(), items.begin(),
+		[this](T object) { return BuildItem{ object, Fatten(GetItemBounds(object), DirectX::SimpleMath::Vector2()), -1 }; });
+	items.erase(std::remove_if(items.begin(), items.end(), [](const BuildItem& item) { return !IsFiniteAABB(item.bounds); }), items.end());
+
+	if (autoGrow_ && !items.empty())
+	{
+		AABB all = items.front().bounds;
+		for (const BuildItem& item : items)
+		{
+			all = AABB(
+				std::min(all.Minimum().x, item.bounds.Minimum().x), std::min(all.Minimum().y, item.bounds.Minimum().y),
+				std::max(all.Maximum().x, item.bounds.Maximum().x), std::max(all.Maximum().y, item.bounds.Maximum().y));
+		}
+		GrowToFit(all);
+	}
+
+	// a range of items that ends up in one node, split into straddlers and the four quadrants
+	struct BuildRange
+	{
+		unsigned node;
+		size_t begin;
+		size_t end;
+		std::array<size_t, 5> quadrantBegin;
+		bool split;
+		Bucket* bucket;
+	};
+
+	std::vector<BuildRange> level{ BuildRange{ RootNode, 0, items.size(), {}, false, nullptr } };
+	std::vector<BuildRange> stored;
+	std::vector<BuildRange> nextLevel;
+
+	auto partition = [&](auto policy, BuildRange& range)
+	{
+		// only reads the pool, and runs on many threads, so it must not copy shared blocks
+		const Node& node = std::as_const(nodes_)[range.node];
+		range.split = range.end - range.begin > maxObjects_ && node.depth_ <= maxDepth_;
+		if (!range.split)
+			return;
+
+		const auto first = items.begin() + range.begin;
+		const auto last = items.begin() + range.end;
+		std::for_each(policy, first, last, [&](BuildItem& item) { item.quadrant = node.GetQuadrant(*this, item.bounds); });
+
+		// straddlers first, then north west, north east, south west, south east
+		const auto straddleEnd = std::partition(policy, first, last, [](const BuildItem& item) { return item.quadrant < 0; });
+		const auto northEnd = std::partition(policy, straddleEnd, last, [](const BuildItem& item) { return item.quadrant < 2; });
+		const auto northWestEnd = std::partition(policy, straddleEnd, northEnd, [](const BuildItem& item) { return item.quadrant == 0; });
+		const auto southWestEnd = std::partition(policy, northEnd, last, [](const BuildItem& item) { return item.quadrant == 2; });
+
+		range.quadrantBegin = {
+			(size_t)(straddleEnd - items.begin()),
+			(size_t)(northWestEnd - items.begin()),
+			(size_t)(northEnd - items.begin()),
+			(size_t)(southWestEnd - items.begin()),
+			range.end };
+	};
+
+	while (!level.empty())
+	{
+		// every range on a level belongs to a different subtree, so they are partitioned in parallel
+		if (level.size() == 1)
+			partition(std::execution::par, level.front());
+		else
+			std::for_each(std::execution::par, level.begin(), level.end(), [&](BuildRange& range) { partition(std::execution::seq, range); });
+
+		// allocating nodes touches the pool, so that part stays on this thread
+		nextLevel.clear();
+		for (BuildRange& range : level)
+		{
+			Node& node = nodes_[range.node];
+			node.count_ = (unsigned)(range.end - range.begin);
+			node.layers_ = node.count_ ? AllLayers : 0;
+
+			if (!range.split)
+			{
+				stored.push_back(range);
+				stored.back().bucket = &node.objects_;
+				continue;
+			}
+
+			node.CreateChildren(*this);
+			stored.push_back(BuildRange{ range.node, range.begin, range.quadrantBegin[0], {}, false, &node.objects_ });
+			for (unsigned i = 0; i < 4; ++i)
+			{
+				nextLevel.push_back(BuildRange{ node.firstChild_ + i, range.quadrantBegin[i], range.quadrantBegin[i + 1], {}, false, nullptr });
+			}
+		}
+		std::swap(level, nextLevel);
+	}
+
+	// each stored range fills a different node's bucket. The buckets were looked up on this thread,
+	// so the workers never touch the pool
+	std::for_each(std::execution::par, stored.begin(), stored.end(), [&](const BuildRange& range)
+	{
+		for (size_t i = range.begin; i < range.end; ++i)
+		{
+			range.bucket->Add(items[i].object, items[i].bounds, items[i].layers);
+		}
+	});
+
+	locations_.reserve(items.size());
+	for (const BuildRange& range : stored)
+	{
+		for (size_t i = range.begin; i < range.end; ++i)
+		{
+			locations_[items[i].object] = Location{ range.node, (unsigned)(i - range.begin) };
+		}
+	}
+	totalObjects_ = (unsigned)items.size();
+
+	return true;
+}
+
+template<typename T, typename BoundsFn>
+float BasicQuadtree<T, BoundsFn>::DistanceSquared(const DirectX::SimpleMath::Vector2& point, const AABB& bounds) noexcept
+{
+	const float dx = std::max({ bounds.Minimum().x - point.x, 0.f, point.x - bounds.Maximum().x });
+	const float dy = std::max({ bounds.Minimum().y - point.y, 0.f, point.y - bounds.Maximum().y });
+	return dx * dx + dy * dy;
+}
+
+template<typename T, typename BoundsFn>
+bool BasicQuadtree<T, BoundsFn>::IntersectSegment(const DirectX::SimpleMath::Vector2& start, const DirectX::SimpleMath::Vector2& delta, const AABB& bounds, float maxFraction, _Out_ float& fraction) noexcept
+{
+	float enter = 0.f;
+	float exit = maxFraction;
+
+	const float origin[2] = { start.x, start.y };
+	const float direction[2] = { delta.x, delta.y };
+	const float minimum[2] = { bounds.Minimum().x, bounds.Minimum().y };
+	const float maximum[2] = { bounds.Maximum().x, bounds.Maximum().y };
+
+	for (unsigned axis = 0; axis < 2; ++axis)
+	{
+		if (std::abs(direction[axis]) < FLT_EPSILON)
+		{
+			// parallel to this slab, so it has to start inside it
+			if (origin[axis] < minimum[axis] || origin[axis] > maximum[axis])
+				return false;
+			continue;
+		}
+
+		const float inverse = 1.f / direction[axis];
+		float nearT = (minimum[axis] - origin[axis]) * inverse;
+		float farT = (maximum[axis] - origin[axis]) * inverse;
+		if (nearT > farT)
+			std::swap(nearT, farT);
+
+		enter = std::max(enter, nearT);
+		exit = std::min(exit, farT);
+		if (enter > exit)
+			return false;
+	}
+
+	fraction = enter;
+	return true;
+}
+
+template<typename T, typename BoundsFn>
+void BasicQuadtree<T, BoundsFn>::Freeze() noexcept
+{
+	frozen_ = true;
+}
+
+template<typename T, typename BoundsFn>
+void BasicQuadtree<T, BoundsFn>::Thaw() noexcept
+{
+	frozen_ = false;
+}
+
+template<typename T, typename BoundsFn>
+bool BasicQuadtree<T, BoundsFn>::IsFrozen() const noexcept
+{
+	return frozen_;
+}
+
+template<typename T, typename BoundsFn>
+void BasicQuadtree<T, BoundsFn>::FindAllPairs(_Inout_ std::vector<ObjectPair>& pairs)
+{
+	pairScratch_.Clear();
+	std::as_const(*this).Root().FindAllPairs(*this, pairScratch_, pairs);
+}
+
+template<typename T, typename BoundsFn>
+void BasicQuadtree<T, BoundsFn>::QueryRegion(const AABB& area, _Inout_ std::vector<T>& results) const
+{
+	QueryRegion(area, [&](T object) { results.push_back(object); });
+}
+
+template<typename T, typename BoundsFn>
+void BasicQuadtree<T, BoundsFn>::QueryRegion(const AABB& area, LayerMask mask, _Inout_ std::vector<T>& results) const
+{
+	QueryRegion(area, mask, [&](T object) { results.push_back(object); });
+}
+
+template<typename T, typename BoundsFn>
+void BasicQuadtree<T, BoundsFn>::QueryPoint(const DirectX::SimpleMath::Vector2& point, _Inout_ std::vector<T>& results) const
+{
+	QueryRegion(AABB(point.x, point.y, point.x, point.y), results);
+}
+
+template<typename T, typename BoundsFn>
+void BasicQuadtree<T, BoundsFn>::QueryRadius(const DirectX::SimpleMath::Vector2& center, float radius, _Inout_ std::vector<T>& results) const
+{
+	const AABB area(center.x - radius, center.y - radius, center.x + radius, center.y + radius);
+	const float radiusSquared = radius * radius;
+
+	QUADTREE_STAT(QueryCost cost);
+	Root().VisitNodes(*this, area, [&](const Node& node)
+	{
+		QUADTREE_STAT(++cost.nodes; cost.tests += node.objects_.Size());
+		node.objects_.ForEachOverlap(area, 0, [&](unsigned slot)
+		{
+			if (DistanceSquared(center, node.objects_.GetBounds(slot)) <= radiusSquared)
+			{
+				QUADTREE_STAT(++cost.candidates);
+				results.push_back(node.objects_[slot]);
+			}
+		});
+	});
+	QUADTREE_STAT(stats_.Record(cost));
+}
+
+template<typename T, typename BoundsFn>
+bool BasicQuadtree<T, BoundsFn>::RayCast(const DirectX::SimpleMath::Vector2& start, const DirectX::SimpleMath::Vector2& end, _Out_ RayHit& hit) const
+{
+	hit = RayHit{};
+	bool found = false;
+	Root().RayCast(*this, start, end - start, hit, found);
+	return found;
+}
+
+template<typename T, typename BoundsFn>
+void BasicQuadtree<T, BoundsFn>::QueryNearest(const DirectX::SimpleMath::Vector2& point, unsigned count, _Inout_ std::vector<T>& nearest) const
+{
+	if (count == 0)
+		return;
+
+	using Entry = std::pair<float, unsigned>;
+
+	// nodes are visited closest first, and the search stops once the closest remaining node is
+	// further away than the furthest of the best objects found so far
+	std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> nodes;
+	std::vector<std::pair<float, T>> best;
+	auto furthest = [](const auto& a, const auto& b) { return a.first < b.first; };
+
+	nodes.emplace(0.f, RootNode);
+	while (!nodes.empty())
+	{
+		const auto [nodeDistance, index] = nodes.top();
+		nodes.pop();
+
+		if (best.size() == count && nodeDistance > best.front().first)
+			break;
+
+		const Node& node = nodes_[index];
+		for (unsigned slot = 0; slot < node.objects_.Size(); ++slot)
+		{
+			const float distance = DistanceSquared(point, node.objects_.GetBounds(slot));
+			if (best.size() < count)
+			{
+				best.emplace_back(distance, node.objects_[slot]);
+				std::push_heap(best.begin(), best.end(), furthest);
+			}
+			else if (distance < best.front().first)
+			{
+				std::pop_heap(best.begin(), best.end(), furthest);
+				best.back() = { distance, node.objects_[slot] };
+				std::push_heap(best.begin(), best.end(), furthest);
+			}
+		}
+
+		if (node.HasChildren())
+		{
+			for (unsigned i = 0; i < 4; ++i)
+			{
+				nodes.emplace(DistanceSquared(point, node.Child(*this, i).GetSearchBounds(*this)), node.firstChild_ + i);
+			}
+		}
+	}
+
+	std::sort_heap(best.begin(), best.end(), furthest);
+	for (const auto& entry : best)
+	{
+		nearest.push_back(entry.second);
+	}
+}
+
+template<typename T, typename BoundsFn>
+const AABB& BasicQuadtree<T, BoundsFn>::GetBounds() const noexcept
+{
+	return Root().GetBounds();
+}
+
+template<typename T, typename BoundsFn>
+unsigned BasicQuadtree<T, BoundsFn>::GetTotalObjects() const noexcept
+{
+	return totalObjects_;
+}
+
+template<typename T, typename BoundsFn>
+void BasicQuadtree<T, BoundsFn>::SetCollapseHysteresis(unsigned hysteresis) noexcept
+{
+	collapseHysteresis_ = hysteresis;
+}
+
+template<typename T, typename BoundsFn>
+void BasicQuadtree<T, BoundsFn>::SetLooseness(float looseness)
+{
+	if (frozen_)
+		return;
+
+	looseness_ = std::max(1.f, looseness);
+	Reinsert();
+}
+
+template<typename T, typename BoundsFn>
+float BasicQuadtree<T, BoundsFn>::GetLooseness() const noexcept
+{
+	return looseness_;
+}
+
+template<typename T, typename BoundsFn>
+void BasicQuadtree<T, BoundsFn>::SetAutoGrow(bool autoGrow) noexcept
+{
+	autoGrow_ = autoGrow;
+}
+
+template<typename T, typename BoundsFn>
+bool BasicQuadtree<T, BoundsFn>::GetAutoGrow() const noexcept
+{
+	return autoGrow_;
+}
+
+#ifdef QUADTREE_STATS
+template<typename T, typename BoundsFn>
+QuadtreeStats BasicQuadtree<T, BoundsFn>::GetStats() const
+{
+	QuadtreeStats stats;
+	unsigned occupiedNodes = 0;
+
+	// every node is counted, so this walks the pool instead of VisitNodes, which skips empty subtrees
+	std::vector<unsigned> pending{ RootNode };
+	while (!pending.empty())
+	{
+		const Node& node = nodes_[pending.back()];
+		pending.pop_back();
+		if (node.HasChildren())
+		{
+			for (unsigned i = 0; i < 4; ++i)
+			{
+				pending.push_back(node.firstChild_ + i);
+			}
+		}
+
+		if (node.depth_ >= stats.nodesPerDepth.size())
+			stats.nodesPerDepth.resize(node.depth_ + 1, 0);
+		stats.nodesPerDepth[node.depth_]++;
+		stats.nodeCount++;
+
+		const unsigned size = node.objects_.Size();
+		stats.maxBucketSize = std::max(stats.maxBucketSize, size);
+		occupiedNodes += size > 0;
+	}
+
+	stats.totalObjects = totalObjects_;
+	stats.rootObjects = Root().objects_.Size();
+	stats.averageBucketSize = occupiedNodes ? static_cast<float>(totalObjects_) / occupiedNodes : 0.f;
+
+	stats.branches = stats_.branches.load(std::memory_order_relaxed);
+	stats.collapses = stats_.collapses.load(std::memory_order_relaxed);
+	stats.queries = stats_.queries.load(std::memory_order_relaxed);
+	stats.nodesVisited = stats_.nodesVisited.load(std::memory_order_relaxed);
+	stats.overlapTests = stats_.overlapTests.load(std::memory_order_relaxed);
+	stats.candidates = stats_.candidates.load(std::memory_order_relaxed);
+
+	if (stats.queries)
+	{
+		stats.nodesPerQuery = static_cast<float>(stats.nodesVisited) / stats.queries;
+		stats.candidatesPerQuery = static_cast<float>(stats.candidates) / stats.queries;
+	}
+	if (stats.overlapTests)
+		stats.falsePositiveRatio = static_cast<float>(stats.overlapTests - stats.candidates) / stats.overlapTests;
+
+	return stats;
+}
+
+template<typename T, typename BoundsFn>
+void BasicQuadtree<T, BoundsFn>::ResetStats() noexcept
+{
+	stats_.branches.store(0, std::memory_order_relaxed);
+	stats_.collapses.store(0, std::memory_order_relaxed);
+	stats_.queries.store(0, std::memory_order_relaxed);
+	stats_.nodesVisited.store(0, std::memory_order_relaxed);
+	stats_.overlapTests.store(0, std::memory_order_relaxed);
+	stats_.candidates.store(0, std::memory_order_relaxed);
+}
+#endif // QUADTREE_STATS
+
+template<typename T, typename BoundsFn>
+void BasicQuadtree<T, BoundsFn>::SetFatMargin(float margin) noexcept
+{
+	fatMargin_ = std::max(0.f, margin);
+}
+
+template<typename T, typename BoundsFn>
+float BasicQuadtree<T, BoundsFn>::GetFatMargin() const noexcept
+{
+	return fatMargin_;
+}
+
+template<typename T, typename BoundsFn>
+void BasicQuadtree<T, BoundsFn>::SetVelocityScale(float scale) noexcept
+{
+	velocityScale_ = std::max(0.f, scale);
+}
+
+template<typename T, typename BoundsFn>
+float BasicQuadtree<T, BoundsFn>::GetVelocityScale() const noexcept
+{
+	return velocityScale_;
+}
+
+template<typename T, typename BoundsFn>
+typename BasicQuadtree<T, BoundsFn>::Snapshot BasicQuadtree<T, BoundsFn>::TakeSnapshot() const
+{
+	return Snapshot(*this);
+}
+
+template<typename T, typename BoundsFn>
+void BasicQuadtree<T, BoundsFn>::Reinsert()
+{
+	std::vector<BuildItem> items;
+	items.reserve(locations_.size());
+	for (const auto& [object, location] : locations_)
+	{
+		const Bucket& bucket = std::as_const(nodes_)[location.node].objects_;
+		items.push_back(BuildItem{ object, bucket.GetBounds(location.slot), -1, bucket.GetLayers(location.slot) });
+	}
+
+	// the root keeps its bounds, Clear() would undo any growing
+	Root().Clear(*this);
+	locations_.clear();
+	for (const BuildItem& item : items)
+	{
+		GrowToFit(item.bounds);
+		Root().Insert(*this, item.object, item.bounds, item.layers);
+	}
+}
+
+template<typename T, typename BoundsFn>
+unsigned BasicQuadtree<T, BoundsFn>::GetCollapseThreshold() const noexcept
+{
+	return maxObjects_ > collapseHysteresis_ ? maxObjects_ - collapseHysteresis_ : 0;
+}
+
+template<typename T, typename BoundsFn>
+void BasicQuadtree<T, BoundsFn>::CollapseUpward(unsigned index)
+{
+	// Commit() walks up from every node it was asked about once it is done
+	if (deferCollapse_)
+	{
+		deferredCollapses_.push_back(index);
+		return;
+	}
+
+	// only counts along this path changed, so the highest ancestor that is now small enough
+	// is the only collapse that can be needed
+	const unsigned threshold = GetCollapseThreshold();
+	unsigned highest = NullNode;
+	for (const Node* node = &std::as_const(nodes_)[index]; ; node = &std::as_const(nodes_)[node->parent_])
+	{
+		if (node->HasChildren() && node->count_ <= threshold)
+			highest = node->index_;
+
+		if (node->parent_ == NullNode)
+			break;
+	}
+
+	if (highest != NullNode)
+		nodes_[highest].Collapse(*this);
+}
+
+template<typename T, typename BoundsFn>
+AABB BasicQuadtree<T, BoundsFn>::Fatten(const AABB& bounds, const DirectX::SimpleMath::Vector2& displacement) const noexcept
+{
+	return FattenAABB(bounds, fatMargin_, displacement * velocityScale_);
+}
+
+template<typename T, typename BoundsFn>
+AABB BasicQuadtree<T, BoundsFn>::GetLooseBounds(const AABB& nodeBounds, float looseness) noexcept
+{
+	using DirectX::SimpleMath::Vector2;
+	const Vector2 center = nodeBounds.Center();
+	const float halfWidth = (nodeBounds.Maximum().x - nodeBounds.Minimum().x) * 0.5f * looseness;
+	const float halfHeight = (nodeBounds.Maximum().y - nodeBounds.Minimum().y) * 0.5f * looseness;
+
+	return AABB(center.x - halfWidth, center.y - halfHeight, center.x + halfWidth, center.y + halfHeight);
+}
+
+template<typename T, typename BoundsFn>
+AABB BasicQuadtree<T, BoundsFn>::GetSearchBounds(const AABB& nodeBounds, const AABB& rootBounds, float looseness) noexcept
+{
+	if (looseness > 1.f)
+		return GetLooseBounds(nodeBounds, looseness);
+
+	// objects are routed by which side of each center line they are on, so a node on the edge of
+	// the tree also holds anything past that edge
+	return AABB(
+		nodeBounds.Minimum().x == rootBounds.Minimum().x ? -FLT_MAX : nodeBounds.Minimum().x,
+		nodeBounds.Minimum().y == rootBounds.Minimum().y ? -FLT_MAX : nodeBounds.Minimum().y,
+		nodeBounds.Maximum().x == rootBounds.Maximum().x ? FLT_MAX : nodeBounds.Maximum().x,
+		nodeBounds.Maximum().y == rootBounds.Maximum().y ? FLT_MAX : nodeBounds.Maximum().y);
+}
+
+template<typename T, typename BoundsFn>
+void BasicQuadtree<T, BoundsFn>::GrowToFit(const AABB& bounds)
+{
+	if (!autoGrow_ || ContainsAABB(GetBounds(), bounds))
+		return;
+
+	// count the steps before changing anything. If the bounds can't be reached within what is
+	// left of the budget the tree is left alone and the object is stored as if auto grow was off
+	unsigned steps = 0;
+	AABB reach = GetBounds();
+	while (!ContainsAABB(reach, bounds))
+	{
+		if (grownDepth_ + steps == MaxGrowDepth)
+			return;
+
+		reach = GetGrownBounds(reach, bounds);
+		if (!IsFiniteAABB(reach))
+			return;
+
+		steps++;
+	}
+
+	for (; steps > 0; --steps)
+	{
+		Grow(bounds);
+	}
+}
+
+template<typename T, typename BoundsFn>
+AABB BasicQuadtree<T, BoundsFn>::GetGrownBounds(const AABB& old, const AABB& towards) noexcept
+{
+	const float width = old.Maximum().x > old.Minimum().x ? old.Maximum().x - old.Minimum().x : 1.f;
+	const float height = old.Maximum().y > old.Minimum().y ? old.Maximum().y - old.Minimum().y : 1.f;
+	const bool west = towards.Minimum().x < old.Minimum().x;
+	const bool north = towards.Minimum().y < old.Minimum().y;
+
+	return AABB(
+		west ? old.Minimum().x - width : old.Minimum().x,
+		north ? old.Minimum().y - height : old.Minimum().y,
+		west ? old.Maximum().x : old.Maximum().x + width,
+		north ? old.Maximum().y : old.Maximum().y + height);
+}
+
+template<typename T, typename BoundsFn>
+void BasicQuadtree<T, BoundsFn>::Grow(const AABB& towards)
+{
+	const AABB old = GetBounds();
+	const bool west = towards.Minimum().x < old.Minimum().x;
+	const bool north = towards.Minimum().y < old.Minimum().y;
+
+	maxDepth_++;
+	grownDepth_++;
+
+	Node& root = Root();
+	root.SetBounds(GetGrownBounds(old, towards));
+	if (!root.HasChildren())
+		return;
+
+	// the old root is moved into the quadrant on the opposite side to the growth
+	const unsigned quadrant = (west ? 1 : 0) + (north ? 2 : 0);
+	const unsigned oldChildren = root.firstChild_;
+	const unsigned oldCount = root.count_;
+	const LayerMask oldLayers = root.layers_;
+	Bucket oldObjects = std::move(root.objects_);
+	root.objects_.Clear();
+
+	root.firstChild_ = NullNode;
+	root.CreateChildren(*this);
+	const unsigned movedIndex = root.firstChild_ + quadrant;
+	Node& moved = nodes_[movedIndex];
+	moved.SetBounds(old);
+	moved.firstChild_ = oldChildren;
+	moved.count_ = oldCount;
+	moved.layers_ = oldLayers;
+	moved.objects_ = std::move(oldObjects);
+	root.count_ = oldCount;
+
+	for (unsigned slot = 0; slot < moved.objects_.Size(); ++slot)
+	{
+		locations_[moved.objects_[slot]].node = movedIndex;
+	}
+
+	for (unsigned i = 0; i < 4; ++i)
+	{
+		moved.Child(*this, i).parent_ = movedIndex;
+	}
+
+	// everything below the old root is one level deeper now, and anything that was only there
+	// because it was outside the old root has to be inserted again from the new root
+	std::vector<BuildItem> strays;
+	std::vector<unsigned> pending{ movedIndex };
+	while (!pending.empty())
+	{
+		Node& node = nodes_[pending.back()];
+		pending.pop_back();
+		if (node.index_ != movedIndex)
+			node.depth_++;
+
+		unsigned slot = 0;
+		while (slot < node.objects_.Size())
+		{
+			const AABB bounds = node.objects_.GetBounds(slot);
+			if (moved.IsRouteFromParent(*this, bounds))
+			{
+				slot++;
+				continue;
+			}
+
+			strays.push_back(BuildItem{ node.objects_[slot], bounds, -1, node.objects_.GetLayers(slot) });
+			node.Unstore(*this, slot);
+		}
+
+		if (node.HasChildren())
+		{
+			for (unsigned i = 0; i < 4; ++i)
+			{
+				pending.push_back(node.firstChild_ + i);
+			}
+		}
+	}
+
+	for (const BuildItem& stray : strays)
+	{
+		root.Insert(*this, stray.object, stray.bounds, stray.layers);
+	}
+}
+
+
+/*****************************************************************************/
+/*							 POOL IMPLEMENTATION							 */
+/*****************************************************************************/
+template<typename T, typename BoundsFn>
+BasicQuadtree<T, BoundsFn>::NodePool::NodePool() : pages_(std::make_shared<PageTable>())
+{
+}
+
+template<typename T, typename BoundsFn>
+unsigned BasicQuadtree<T, BoundsFn>::NodePool::AllocateBlock()
+{
+	if (!freeBlocks_.empty())
+	{
+		const unsigned block = freeBlocks_.back();
+		freeBlocks_.pop_back();
+		return block;
+	}
+
+	// PageSize is a multiple of BlockSize, so a block never straddles two pages
+	PageTable& pages = MakeUnique(pages_);
+	std::atomic_thread_fence(std::memory_order_acquire);
+	if ((used_ >> PageShift) >= pages.size())
+	{
+		pages.emplace_back(std::make_shared<Page>());
+	}
+
+	Page& page = MakeUnique(pages[used_ >> PageShift]);
+	std::atomic_thread_fence(std::memory_order_acquire);
+	page[(used_ & PageMask) / BlockSize] = std::make_shared<Block>();
+
+	const unsigned block = used_;
+	used_ += BlockSize;
+	return block;
+}
+
+template<typename T, typename BoundsFn>
+void BasicQuadtree<T, BoundsFn>::NodePool::FreeBlock(unsigned firstNode)
+{
+	for (unsigned i = 0; i < BlockSize; ++i)
+	{
+		Node& node = (*this)[firstNode + i];
+		node.objects_.Clear();
+		node.firstChild_ = NullNode;
+		node.count_ = 0;
+		node.layers_ = 0;
+	}
+	freeBlocks_.push_back(firstNode);
+}
+
+template<typename T, typename BoundsFn>
+typename BasicQuadtree<T, BoundsFn>::NodePool BasicQuadtree<T, BoundsFn>::NodePool::Share() const noexcept
+{
+	NodePool shared;
+	shared.pages_ = pages_;
+	shared.used_ = used_;
+	return shared;
+}
+
+template<typename T, typename BoundsFn>
+typename BasicQuadtree<T, BoundsFn>::Node& BasicQuadtree<T, BoundsFn>::NodePool::operator[](unsigned index)
+{
+	Page& page = MakeUnique(MakeUnique(pages_)[index >> PageShift]);
+	Block& block = MakeUnique(page[(index & PageMask) / BlockSize]);
+
+	// once nothing had to be copied this is the only fence, see MakeUnique()
+	std::atomic_thread_fence(std::memory_order_acquire);
+	return block[index % BlockSize];
+}
+
+template<typename T, typename BoundsFn>
+const typename BasicQuadtree<T, BoundsFn>::Node& BasicQuadtree<T, BoundsFn>::NodePool::operator[](unsigned index) const noexcept
+{
+	const Page& page = *(*pages_)[index >> PageShift];
+	return (*page[(index & PageMask) / BlockSize])[index % BlockSize];
+}
+
+template<typename T, typename BoundsFn>
+template<typename Part>
+Part& BasicQuadtree<T, BoundsFn>::NodePool::MakeUnique(std::shared_ptr<Part>& shared)
+{
+	// a snapshot released on another thread must be finished with a part before it is written.
+	// Replacing the pointer writes to the part that holds it, so that part is fenced here, and
+	// the caller fences before writing to the part that is returned.
+	if (shared.use_count() != 1)
+	{
+		std::atomic_thread_fence(std::memory_order_acquire);
+		shared = std::make_shared<Part>(*shared);
+	}
+
+	return *shared;
+}
+
+
+/*****************************************************************************/
+/*							SNAPSHOT IMPLEMENTATION							 */
+/*****************************************************************************/
+template<typename T, typename BoundsFn>
+const AABB& BasicQuadtree<T, BoundsFn>::Snapshot::GetBounds() const noexcept
+{
+	return nodes_[RootNode].GetBounds();
+}
+
+template<typename T, typename BoundsFn>
+unsigned BasicQuadtree<T, BoundsFn>::Snapshot::GetTotalObjects() const noexcept
+{
+	return totalObjects_;
+}
+
+template<typename T, typename BoundsFn>
+void BasicQuadtree<T, BoundsFn>::Snapshot::QueryRegion(const AABB& area, _Inout_ std::vector<T>& results) const
+{
+	QueryRegion(area, [&](T object) { results.push_back(object); });
+}
+
+template<typename T, typename BoundsFn>
+void BasicQuadtree<T, BoundsFn>::Snapshot::QueryRegion(const AABB& area, LayerMask mask, _Inout_ std::vector<T>& results) const
+{
+	QueryRegion(area, mask, [&](T object) { results.push_back(object); });
+}
+
+template<typename T, typename BoundsFn>
+bool BasicQuadtree<T, BoundsFn>::Snapshot::RayCast(const DirectX::SimpleMath::Vector2& start, const DirectX::SimpleMath::Vector2& end, _Out_ RayHit& hit) const
+{
+	hit = RayHit{};
+	bool found = false;
+	RayCast(RootNode, start, end - start, hit, found);
+	return found;
+}
+
+template<typename T, typename BoundsFn>
+BasicQuadtree<T, BoundsFn>::Snapshot::Snapshot(const BasicQuadtree& tree) noexcept : nodes_(tree.nodes_.Share()), looseness_(tree.looseness_), totalObjects_(tree.totalObjects_)
+{
+}
+
+template<typename T, typename BoundsFn>
+void BasicQuadtree<T, BoundsFn>::Snapshot::RayCast(unsigned index, const DirectX::SimpleMath::Vector2& start, const DirectX::SimpleMath::Vector2& delta, _Inout_ RayHit& hit, _Inout_ bool& found) const noexcept
+{
+	const Node& node = nodes_[index];
+	for (unsigned slot = 0; slot < node.objects_.Size(); ++slot)
+	{
+		float fraction;
+		if (IntersectSegment(start, delta, node.objects_.GetBounds(slot), hit.fraction, fraction) &&
+			(!found || fraction < hit.fraction))
+		{
+			hit.object = node.objects_[slot];
+			hit.fraction = fraction;
+			found = true;
+		}
+	}
+
+	if (!node.HasChildren())
+		return;
+
+	std::array<std::pair<float, unsigned>, 4> order;
+	unsigned count = 0;
+	for (unsigned i = 0; i < 4; ++i)
+	{
+		float fraction;
+		if (IntersectSegment(start, delta, GetSearchBounds(nodes_[node.firstChild_ + i]), hit.fraction, fraction))
+			order[count++] = { fraction, node.firstChild_ + i };
+	}
+	std::sort(order.begin(), order.begin() + count);
+
+	for (unsigned i = 0; i < count; ++i)
+	{
+		if (found && order[i].first > hit.fraction)
+			break;
+
+		RayCast(order[i].second, start, delta, hit, found);
+	}
+}
+
+template<typename T, typename BoundsFn>
+AABB BasicQuadtree<T, BoundsFn>::Snapshot::GetSearchBounds(const Node& node) const noexcept
+{
+	return BasicQuadtree::GetSearchBounds(node.bounds_, GetBounds(), looseness_);
+}
+
+
+/*****************************************************************************/
+/*							BUCKET IMPLEMENTATION							 */
+/*****************************************************************************/
+template<typename T, typename BoundsFn>
+void BasicQuadtree<T, BoundsFn>::Bucket::Add(T object, const AABB& bounds, LayerMask layers)
+{
+	minX_.push_back(bounds.Minimum().x);
+	minY_.push_back(bounds.Minimum().y);
+	maxX_.push_back(bounds.Maximum().x);
+	maxY_.push_back(bounds.Maximum().y);
+	objects_.push_back(object);
+	layers_.push_back(layers);
+	layerUnion_ |= layers;
+}
+
+template<typename T, typename BoundsFn>
+void BasicQuadtree<T, BoundsFn>::Bucket::RemoveAt(unsigned slot) noexcept
+{
+	const unsigned last = Size() - 1;
+	if (slot != last)
+	{
+		minX_[slot] = minX_[last];
+		minY_[slot] = minY_[last];
+		maxX_[slot] = maxX_[last];
+		maxY_[slot] = maxY_[last];
+		objects_[slot] = objects_[last];
+		layers_[slot] = layers_[last];
+	}
+	minX_.pop_back();
+	minY_.pop_back();
+	maxX_.pop_back();
+	maxY_.pop_back();
+	objects_.pop_back();
+	layers_.pop_back();
+	RefreshLayerUnion();
+}
+
+template<typename T, typename BoundsFn>
+void BasicQuadtree<T, BoundsFn>::Bucket::SetBounds(unsigned slot, const AABB& bounds) noexcept
+{
+	minX_[slot] = bounds.Minimum().x;
+	minY_[slot] = bounds.Minimum().y;
+	maxX_[slot] = bounds.Maximum().x;
+	maxY_[slot] = bounds.Maximum().y;
+}
+
+template<typename T, typename BoundsFn>
+void BasicQuadtree<T, BoundsFn>::Bucket::SetLayers(unsigned slot, LayerMask layers) noexcept
+{
+	layers_[slot] = layers;
+	RefreshLayerUnion();
+}
+
+template<typename T, typename BoundsFn>
+void BasicQuadtree<T, BoundsFn>::Bucket::TakeAll(Bucket& other)
+{
+	Append(other);
+	other.Clear();
+}
+
+template<typename T, typename BoundsFn>
+void BasicQuadtree<T, BoundsFn>::Bucket::Append(const Bucket& other)
+{
+	minX_.insert(minX_.end(), other.minX_.begin(), other.minX_.end());
+	minY_.insert(minY_.end(), other.minY_.begin(), other.minY_.end());
+	maxX_.insert(maxX_.end(), other.maxX_.begin(), other.maxX_.end());
+	maxY_.insert(maxY_.end(), other.maxY_.begin(), other.maxY_.end());
+	objects_.insert(objects_.end(), other.objects_.begin(), other.objects_.end());
+	layers_.insert(layers_.end(), other.layers_.begin(), other.layers_.end());
+	layerUnion_ |= other.layerUnion_;
+}
+
+template<typename T, typename BoundsFn>
+void BasicQuadtree<T, BoundsFn>::Bucket::Truncate(unsigned size) noexcept
+{
+	minX_.resize(size);
+	minY_.resize(size);
+	maxX_.resize(size);
+	maxY_.resize(size);
+	objects_.resize(size);
+	layers_.resize(size);
+	RefreshLayerUnion();
+}
+
+template<typename T, typename BoundsFn>
+void BasicQuadtree<T, BoundsFn>::Bucket::Clear() noexcept
+{
+	minX_.clear();
+	minY_.clear();
+	maxX_.clear();
+	maxY_.clear();
+	objects_.clear();
+	layers_.clear();
+	layerUnion_ = 0;
+}
+
+template<typename T, typename BoundsFn>
+void BasicQuadtree<T, BoundsFn>::Bucket::RefreshLayerUnion() noexcept
+{
+	layerUnion_ = 0;
+	for (LayerMask layers : layers_)
+	{
+		layerUnion_ |= layers;
+	}
+}
+
+
+/*****************************************************************************/
+/*							 NODE IMPLEMENTATION							 */
+/*****************************************************************************/
+/*****************************************************************************/
+/*                            PUBLIC FUNCTIONS                               */
+/*****************************************************************************/
+template<typename T, typename BoundsFn>
+bool BasicQuadtree<T, BoundsFn>::Node::Insert(BasicQuadtree& tree, T object, const AABB& bounds, LayerMask layers)
+{
+	Node* node = GetNodeForInsertion(tree, bounds);
+
+	if (node == this)
+	{
+		Store(tree, object, bounds, layers);
+		return true;
+	}
+	else
+	{
+		return node->Insert(tree, object, bounds, layers);
+	}
+}
+
+template<typename T, typename BoundsFn>
+bool BasicQuadtree<T, BoundsFn>::Node::Update(BasicQuadtree& tree, unsigned slot, _In_ const AABB& newBounds)
+{
+	// the deepest node whose path from the root would still lead an insert with the new bounds here
+	const NodePool& nodes = tree.nodes_;
+	unsigned target = index_;
+	for (const Node* node = this; node->parent_ != NullNode; node = &nodes[node->parent_])
+	{
+		if (!node->IsRouteFromParent(tree, newBounds))
+			target = node->parent_;
+	}
+
+	if (target == index_ && (!HasChildren() || GetQuadrant(tree, newBounds) < 0))
+	{
+		objects_.SetBounds(slot, newBounds);
+		return true;
+	}
+
+	T object = objects_[slot];
+	const LayerMask layers = objects_.GetLayers(slot);
+	Unstore(tree, slot);
+
+	const unsigned parent = parent_;
+	tree.nodes_[target].Insert(tree, object, newBounds, layers);
+
+	if (parent != NullNode)
+		tree.CollapseUpward(parent);
+
+	return true;
+}
+
+template<typename T, typename BoundsFn>
+void BasicQuadtree<T, BoundsFn>::Node::Remove(BasicQuadtree& tree, unsigned slot)
+{
+	tree.locations_.erase(objects_[slot]);
+	Unstore(tree, slot);
+
+	if (parent_ != NullNode)
+		tree.CollapseUpward(parent_);
+}
+
+template<typename T, typename BoundsFn>
+const AABB& BasicQuadtree<T, BoundsFn>::Node::GetBounds() const noexcept
+{
+	return bounds_;
+}
+
+template<typename T, typename BoundsFn>
+void BasicQuadtree<T, BoundsFn>::Node::SetBounds(const AABB& bounds) noexcept
+{
+	using DirectX::SimpleMath::Vector2;
+	bounds_ = bounds;
+	/*
+	if (HasChildren())
+	{
+		const Vector2 center = bounds_.Center();
+
+		Child(0).SetBounds(AABB(bounds_.Minimum().x, bounds_.Minimum().y, center.x, center.y));
+
+		Child(1).SetBounds(AABB(center.x, bounds_.Minimum().y, bounds_.Maximum().x, center.y));
+
+		Child(2).SetBounds(AABB(bounds_.Minimum().x, center.y, center.x, bounds_.Maximum().y));
+
+		Child(3).SetBounds(AABB(center.x, center.y, bounds_.Maximum().x, bounds_.Maximum().y));
+	}
+	*/
+}
+
+template<typename T, typename BoundsFn>
+void BasicQuadtree<T, BoundsFn>::Node::Clear(BasicQuadtree& tree)
+{
+	tree.totalObjects_ -= objects_.Size();
+	objects_.Clear();
+	count_ = 0;
+	layers_ = 0;
+
+	if (HasChildren())
+	{
+		for (unsigned i = 0; i < 4; ++i)
+		{
+			Child(tree, i).Clear(tree);
+		}
+		tree.nodes_.FreeBlock(firstChild_);
+		firstChild_ = NullNode;
+	}
+}
+
+/*****************************************************************************/
+/*                            PRIVATE FUNCTIONS                              */
+/*****************************************************************************/
+template<typename T, typename BoundsFn>
+typename BasicQuadtree<T, BoundsFn>::Node& BasicQuadtree<T, BoundsFn>::Node::Child(BasicQuadtree& tree, unsigned quadrant)
+{
+	return tree.nodes_[firstChild_ + quadrant];
+}
+
+template<typename T, typename BoundsFn>
+const typename BasicQuadtree<T, BoundsFn>::Node& BasicQuadtree<T, BoundsFn>::Node::Child(const BasicQuadtree& tree, unsigned quadrant) const noexcept
+{
+	return tree.nodes_[firstChild_ + quadrant];
+}
+
+template<typename T, typename BoundsFn>
+typename BasicQuadtree<T, BoundsFn>::Node& BasicQuadtree<T, BoundsFn>::Node::Parent(BasicQuadtree& tree)
+{
+	return tree.nodes_[parent_];
+}
+
+template<typename T, typename BoundsFn>
+void BasicQuadtree<T, BoundsFn>::Node::RayCast(const BasicQuadtree& tree, const DirectX::SimpleMath::Vector2& start, const DirectX::SimpleMath::Vector2& delta, _Inout_ RayHit& hit, _Inout_ bool& found) const noexcept
+{
+	for (unsigned slot = 0; slot < objects_.Size(); ++slot)
+	{
+		float fraction;
+		if (IntersectSegment(start, delta, objects_.GetBounds(slot), hit.fraction, fraction) &&
+			(!found || fraction < hit.fraction))
+		{
+			hit.object = objects_[slot];
+			hit.fraction = fraction;
+			found = true;
+		}
+	}
+
+	if (!HasChildren())
+		return;
+
+	// visit the children in the order the segment enters them, skipping any it reaches after the best hit
+	std::array<std::pair<float, unsigned>, 4> order;
+	unsigned count = 0;
+	for (unsigned i = 0; i < 4; ++i)
+	{
+		float fraction;
+		if (IntersectSegment(start, delta, Child(tree, i).GetSearchBounds(tree), hit.fraction, fraction))
+			order[count++] = { fraction, i };
+	}
+	std::sort(order.begin(), order.begin() + count);
+
+	for (unsigned i = 0; i < count; ++i)
+	{
+		if (found && order[i].first > hit.fraction)
+			break;
+
+		Child(tree, order[i].second).RayCast(tree, start, delta, hit, found);
+	}
+}
+
+template<typename T, typename BoundsFn>
+void BasicQuadtree<T, BoundsFn>::Node::FindAllPairs(const BasicQuadtree& tree, _Inout_ Bucket& ancestors, _Inout_ std::vector<ObjectPair>& pairs) const
+{
+	const unsigned size = objects_.Size();
+	for (unsigned i = 0; i < size; ++i)
+	{
+		T object = objects_[i];
+		const AABB bounds = objects_.GetBounds(i);
+
+		// everything above this node, then only the later slots here so each pair is seen once
+		ancestors.ForEachOverlap(bounds, 0, [&](unsigned slot) { pairs.emplace_back(ancestors[slot], object); });
+		objects_.ForEachOverlap(bounds, i + 1, [&](unsigned slot) { pairs.emplace_back(object, objects_[slot]); });
+	}
+
+	if (HasChildren())
+	{
+		const unsigned ancestorCount = ancestors.Size();
+		ancestors.Append(objects_);
+
+		for (unsigned i = 0; i < 4; ++i)
+		{
+			Child(tree, i).FindAllPairs(tree, ancestors, pairs);
+		}
+
+		ancestors.Truncate(ancestorCount);
+
+		// loose siblings overlap, so objects in different children can overlap too
+		if (tree.looseness_ > 1.f)
+		{
+			for (unsigned i = 0; i < 4; ++i)
+			{
+				for (unsigned j = i + 1; j < 4; ++j)
+				{
+					if (Child(tree, i).GetLooseBounds(tree).Overlaps(Child(tree, j).GetLooseBounds(tree)))
+						Child(tree, i).FindPairsAcross(tree, Child(tree, j), pairs);
+				}
+			}
+		}
+	}
+}
+
+template<typename T, typename BoundsFn>
+void BasicQuadtree<T, BoundsFn>::Node::FindPairsAcross(const BasicQuadtree& tree, const Node& other, _Inout_ std::vector<ObjectPair>& pairs) const
+{
+	for (unsigned i = 0; i < objects_.Size(); ++i)
+	{
+		other.FindPairsWith(tree, objects_[i], objects_.GetBounds(i), pairs);
+	}
+
+	if (HasChildren())
+	{
+		const AABB otherBounds = other.GetLooseBounds(tree);
+		for (unsigned i = 0; i < 4; ++i)
+		{
+			if (Child(tree, i).GetLooseBounds(tree).Overlaps(otherBounds))
+				Child(tree, i).FindPairsAcross(tree, other, pairs);
+		}
+	}
+}
+
+template<typename T, typename BoundsFn>
+void BasicQuadtree<T, BoundsFn>::Node::FindPairsWith(const BasicQuadtree& tree, T object, const AABB& bounds, _Inout_ std::vector<ObjectPair>& pairs) const
+{
+	objects_.ForEachOverlap(bounds, 0, [&](unsigned slot) { pairs.emplace_back(object, objects_[slot]); });
+
+	if (HasChildren())
+	{
+		for (unsigned i = 0; i < 4; ++i)
+		{
+			if (Child(tree, i).GetLooseBounds(tree).Overlaps(bounds))
+				Child(tree, i).FindPairsWith(tree, object, bounds, pairs);
+		}
+	}
+}
+
+template<typename T, typename BoundsFn>
+void BasicQuadtree<T, BoundsFn>::Node::Branch(BasicQuadtree& tree)
+{
+	QUADTREE_STAT(tree.stats_.branches.fetch_add(1, std::memory_order_relaxed));
+	CreateChildren(tree);
+
+	unsigned slot = 0;
+	while (slot < objects_.Size())
+	{
+		const AABB bounds = objects_.GetBounds(slot);
+		Node* node = GetNodeForInsertion(tree, bounds);
+		if (node != this)
+		{
+			node->Insert(tree, objects_[slot], bounds, objects_.GetLayers(slot));
+			Unstore(tree, slot);
+		}
+		else
+		{
+			slot++;
+		}
+	}
+}
+
+template<typename T, typename BoundsFn>
+void BasicQuadtree<T, BoundsFn>::Node::CreateChildren(BasicQuadtree& tree)
+{
+	using DirectX::SimpleMath::Vector2;
+	const Vector2 center = bounds_.Center();
+
+	// the pool never moves existing nodes, so this stays valid while the block is allocated
+	const unsigned first = tree.nodes_.AllocateBlock();
+	NodePool& nodes = tree.nodes_;
+
+	nodes[first + 0] = Node(first + 0, depth_ + 1,
+		AABB(bounds_.Minimum().x, bounds_.Minimum().y, center.x, center.y),
+		index_);
+
+	nodes[first + 1] = Node(first + 1, depth_ + 1,
+		AABB(center.x, bounds_.Minimum().y, bounds_.Maximum().x, center.y),
+		index_);
+
+	nodes[first + 2] = Node(first + 2, depth_ + 1,
+		AABB(bounds_.Minimum().x, center.y, center.x, bounds_.Maximum().y),
+		index_);
+
+	nodes[first + 3] = Node(first + 3, depth_ + 1,
+		AABB(center.x, center.y, bounds_.Maximum().x, bounds_.Maximum().y),
+		index_);
+
+	firstChild_ = first;
+}
+
+template<typename T, typename BoundsFn>
+void BasicQuadtree<T, BoundsFn>::Node::Collapse(BasicQuadtree& tree)
+{
+	if (!HasChildren())
+	{
+		return;
+	}
+
+	QUADTREE_STAT(tree.stats_.collapses.fetch_add(1, std::memory_order_relaxed));
+	const unsigned firstMoved = objects_.Size();
+	for (unsigned i = 0; i < 4; ++i)
+	{
+		Node& child = Child(tree, i);
+		child.Collapse(tree);
+		objects_.TakeAll(child.objects_);
+	}
+
+	for (unsigned slot = firstMoved; slot < objects_.Size(); ++slot)
+	{
+		tree.locations_[objects_[slot]] = Location{ index_, slot };
+	}
+
+	tree.nodes_.FreeBlock(firstChild_);
+	firstChild_ = NullNode;
+}
+
+template<typename T, typename BoundsFn>
+void BasicQuadtree<T, BoundsFn>::Node::Store(BasicQuadtree& tree, T object, const AABB& bounds, LayerMask layers)
+{
+	tree.locations_[object] = Location{ index_, objects_.Size() };
+	objects_.Add(object, bounds, layers);
+	tree.totalObjects_++;
+
+	for (Node* node = this; ; node = &node->Parent(tree))
+	{
+		node->count_++;
+		node->layers_ |= layers;
+		if (node->parent_ == NullNode)
+			break;
+	}
+}
+
+template<typename T, typename BoundsFn>
+void BasicQuadtree<T, BoundsFn>::Node::Unstore(BasicQuadtree& tree, unsigned slot)
+{
+	objects_.RemoveAt(slot);
+	tree.totalObjects_--;
+
+	for (Node* node = this; ; node = &node->Parent(tree))
+	{
+		node->count_--;
+		if (node->parent_ == NullNode)
+			break;
+	}
+
+	// the last object was moved into the empty slot
+	if (slot < objects_.Size())
+	{
+		tree.locations_[objects_[slot]].slot = slot;
+	}
+
+	RefreshLayers(tree);
+}
+
+template<typename T, typename BoundsFn>
+void BasicQuadtree<T, BoundsFn>::Node::RefreshLayers(BasicQuadtree& tree)
+{
+	for (Node* node = this; ; node = &node->Parent(tree))
+	{
+		LayerMask layers = node->objects_.GetLayerUnion();
+		if (node->HasChildren())
+		{
+			for (unsigned i = 0; i < 4; ++i)
+			{
+				layers |= node->Child(std::as_const(tree), i).layers_;
+			}
+		}
+
+		// the ancestors already hold the same layers
+		if (layers == node->layers_)
+			break;
+
+		node->layers_ = layers;
+		if (node->parent_ == NullNode)
+			break;
+	}
+}
+
+template<typename T, typename BoundsFn>
+unsigned BasicQuadtree<T, BoundsFn>::Node::GetObjectCountInNode() const noexcept
+{
+	return count_;
+}
+
+template<typename T, typename BoundsFn>
+int BasicQuadtree<T, BoundsFn>::Node::GetQuadrant(const BasicQuadtree& tree, _In_ const AABB& objectBounds) const noexcept
+{
+	using DirectX::SimpleMath::Vector2;
+	const Vector2 center = bounds_.Center();
+
+	if (tree.looseness_ > 1.f)
+	{
+		// pick the child by the object's center, then make sure it fits that child's loose bounds
+		const Vector2 objectCenter = objectBounds.Center();
+		const int quadrant = (objectCenter.x > center.x ? 1 : 0) + (objectCenter.y > center.y ? 2 : 0);
+
+		const float halfWidth = (bounds_.Maximum().x - bounds_.Minimum().x) * 0.25f * tree.looseness_;
+		const float halfHeight = (bounds_.Maximum().y - bounds_.Minimum().y) * 0.25f * tree.looseness_;
+		const float childX = (quadrant & 1) ? (center.x + bounds_.Maximum().x) * 0.5f : (bounds_.Minimum().x + center.x) * 0.5f;
+		const float childY = (quadrant & 2) ? (center.y + bounds_.Maximum().y) * 0.5f : (bounds_.Minimum().y + center.y) * 0.5f;
+
+		const bool fits =
+			objectBounds.Minimum().x >= childX - halfWidth && objectBounds.Maximum().x <= childX + halfWidth &&
+			objectBounds.Minimum().y >= childY - halfHeight && objectBounds.Maximum().y <= childY + halfHeight;
+
+		return fits ? quadrant : -1;
+	}
+
+	const bool north = objectBounds.Minimum().y < center.y&& objectBounds.Maximum().y < center.y;
+	const bool south = objectBounds.Minimum().y > center.y;
+	const bool west = objectBounds.Minimum().x < center.x&& objectBounds.Maximum().x < center.x;
+	const bool east = objectBounds.Minimum().x > center.x;
+
+	if (east)
+	{
+		if (north)
+			return 1;
+		else if (south)
+			return 3;
+	}
+	else if (west)
+	{
+		if (north)
+			return 0;
+		else if (south)
+			return 2;
+	}
+
+	return -1;
+}
+
+template<typename T, typename BoundsFn>
+AABB BasicQuadtree<T, BoundsFn>::Node::GetLooseBounds(const BasicQuadtree& tree) const noexcept
+{
+	return BasicQuadtree::GetLooseBounds(bounds_, tree.looseness_);
+}
+
+template<typename T, typename BoundsFn>
+AABB BasicQuadtree<T, BoundsFn>::Node::GetSearchBounds(const BasicQuadtree& tree) const noexcept
+{
+	return BasicQuadtree::GetSearchBounds(bounds_, tree.GetBounds(), tree.looseness_);
+}
+
+template<typename T, typename BoundsFn>
+bool BasicQuadtree<T, BoundsFn>::Node::IsRouteFromParent(const BasicQuadtree& tree, _In_ const AABB& objectBounds) const noexcept
+{
+	if (parent_ == NullNode)
+		return true;
+
+	const Node& parent = tree.nodes_[parent_];
+	return parent.GetQuadrant(tree, objectBounds) == (int)(index_ - parent.firstChild_);
+}
+
+template<typename T, typename BoundsFn>
+typename BasicQuadtree<T, BoundsFn>::Node* BasicQuadtree<T, BoundsFn>::Node::GetNodeForInsertion(BasicQuadtree& tree, _In_ const AABB& objectBounds)
+{
+	// the nodes passed on the way down are only read, so their blocks are not copied
+	const Node* node = this;
+	for (;;)
+	{
+		if ((!node->HasChildren() && node->objects_.Size() < tree.maxObjects_) || node->depth_ > tree.maxDepth_)
+			break;
+
+		const int quadrant = node->GetQuadrant(tree, objectBounds);
+		if (quadrant < 0)
+			break;
+
+		if (!node->HasChildren())
+		{
+			Node& leaf = tree.nodes_[node->index_];
+			leaf.Branch(tree);
+			node = &leaf;
+		}
+		node = &node->Child(std::as_const(tree), quadrant);
+	}
+
+	return node == this ? this : &tree.nodes_[node->index_];
+}
+
+/*****************************************************************************/
+/*                            TEMPLATE FUNCTIONS                             */
+/*****************************************************************************/
+template<typename T, typename BoundsFn>
+template<typename Visitor> requires std::invocable<Visitor&, T>
+bool BasicQuadtree<T, BoundsFn>::GetCollisionCandidates(T object, Visitor&& visitor) const
+{
+	return GetCollisionCandidates(object, AllLayers, visitor);
+}
+
+template<typename T, typename BoundsFn>
+template<typename Visitor> requires std::invocable<Visitor&, T>
+bool BasicQuadtree<T, BoundsFn>::GetCollisionCandidates(T object, LayerMask mask, Visitor&& visitor) const
+{
+	return VisitOverlaps(GetItemBounds(object), mask, &object, visitor);
+}
+
+template<typename T, typename BoundsFn>
+template<typename Visitor> requires std::invocable<Visitor&, T>
+bool BasicQuadtree<T, BoundsFn>::QueryRegion(const AABB& area, Visitor&& visitor) const
+{
+	return QueryRegion(area, AllLayers, visitor);
+}
+
+template<typename T, typename BoundsFn>
+template<typename Visitor> requires std::invocable<Visitor&, T>
+bool BasicQuadtree<T, BoundsFn>::QueryRegion(const AABB& area, LayerMask mask, Visitor&& visitor) const
+{
+	return VisitOverlaps(area, mask, nullptr, visitor);
+}
+
+template<typename T, typename BoundsFn>
+template<typename Visitor>
+bool BasicQuadtree<T, BoundsFn>::VisitOverlaps(const AABB& area, LayerMask mask, const T* exclude, Visitor&& visitor) const
+{
+	QUADTREE_STAT(QueryCost cost);
+	const bool finished = Root().VisitNodes(*this, area, mask, [&](const Node& node)
+	{
+		QUADTREE_STAT(++cost.nodes; cost.tests += (node.objects_.GetLayerUnion() & mask) ? node.objects_.Size() : 0);
+		return node.objects_.ForEachOverlap(area, 0, mask, [&](unsigned slot)
+		{
+			const T object = node.objects_[slot];
+			if (exclude && object == *exclude)
+				return true;
+
+			QUADTREE_STAT(++cost.candidates);
+			return Visit(visitor, object);
+		});
+	});
+	QUADTREE_STAT(stats_.Record(cost));
+	return finished;
+}
+
+template<typename T, typename BoundsFn>
+template<typename Visitor>
+void BasicQuadtree<T, BoundsFn>::ForEachObject(Visitor&& visitor) const
+{
+	Root().VisitNodes(*this, AABB(-FLT_MAX, -FLT_MAX, FLT_MAX, FLT_MAX), [&](const Node& node)
+	{
+		for (unsigned slot = 0; slot < node.objects_.Size(); ++slot)
+		{
+			visitor(node.objects_[slot], node.objects_.GetBounds(slot));
+		}
+	});
+}
+
+template<typename T, typename BoundsFn>
+template<typename Visitor, typename... Args>
+bool BasicQuadtree<T, BoundsFn>::Visit(Visitor& visitor, Args&&... args)
+{
+	if constexpr (std::is_void_v<std::invoke_result_t<Visitor&, Args...>>)
+	{
+		visitor(std::forward<Args>(args)...);
+		return true;
+	}
+	else
+	{
+		return static_cast<bool>(visitor(std::forward<Args>(args)...));
+	}
+}
+
+template<typename T, typename BoundsFn>
+template<typename Visitor>
+bool BasicQuadtree<T, BoundsFn>::Node::VisitNodes(const BasicQuadtree& tree, const AABB& area, LayerMask mask, Visitor&& visitor) const
+{
+	if (!(layers_ & mask))
+		return true;
+
+	if (!Visit(visitor, *this))
+		return false;
+
+	if (!HasChildren())
+		return true;
+
+	for (unsigned i = 0; i < 4; ++i)
+	{
+		const Node& child = Child(tree, i);
+		if (child.GetSearchBounds(tree).Overlaps(area) && !child.VisitNodes(tree, area, mask, visitor))
+			return false;
+	}
+
+	return true;
+}
+
+template<typename T, typename BoundsFn>
+template<typename Visitor> requires std::invocable<Visitor&, T>
+bool BasicQuadtree<T, BoundsFn>::Snapshot::QueryRegion(const AABB& area, Visitor&& visitor) const
+{
+	return QueryRegion(area, AllLayers, visitor);
+}
+
+template<typename T, typename BoundsFn>
+template<typename Visitor> requires std::invocable<Visitor&, T>
+bool BasicQuadtree<T, BoundsFn>::Snapshot::QueryRegion(const AABB& area, LayerMask mask, Visitor&& visitor) const
+{
+	auto visitNode = [&](const Node& node)
+	{
+		return node.objects_.ForEachOverlap(area, 0, mask, [&](unsigned slot)
+		{
+			return Visit(visitor, node.objects_[slot]);
+		});
+	};
+	return VisitNodes(RootNode, area, mask, visitNode);
+}
+
+template<typename T, typename BoundsFn>
+template<typename Visitor>
+bool BasicQuadtree<T, BoundsFn>::Snapshot::VisitNodes(unsigned index, const AABB& area, LayerMask mask, Visitor& visitor) const
+{
+	const Node& node = nodes_[index];
+	if (!(node.layers_ & mask))
+		return true;
+
+	if (!Visit(visitor, node))
+		return false;
+
+	if (!node.HasChildren())
+		return true;
+
+	for (unsigned i = 0; i < 4; ++i)
+	{
+		const unsigned child = node.firstChild_ + i;
+		if (GetSearchBounds(nodes_[child]).Overlaps(area) && !VisitNodes(child, area, mask, visitor))
+			return false;
+	}
+
+	return true;
+}
+
+template<typename T, typename BoundsFn>
+template<typename Visitor>
+bool BasicQuadtree<T, BoundsFn>::Bucket::ForEachOverlap(const AABB& area, unsigned first, Visitor&& visitor) const
+{
+	// hits are compacted into a stack buffer, so large buckets are tested in chunks
+	constexpr unsigned ChunkSize = 256;
+	unsigned hits[ChunkSize];
+
+	const unsigned size = Size();
+	for (; first < size; first += ChunkSize)
+	{
+		const unsigned count = std::min(ChunkSize, size - first);
+		const unsigned hitCount = BatchOverlaps(
+			minX_.data() + first, minY_.data() + first,
+			maxX_.data() + first, maxY_.data() + first,
+			count, area, hits);
+
+		for (unsigned h = 0; h < hitCount; ++h)
+		{
+			if (!Visit(visitor, first + hits[h]))
+				return false;
+		}
+	}
+
+	return true;
+}
+
+template<typename T, typename BoundsFn>
+template<typename Visitor>
+bool BasicQuadtree<T, BoundsFn>::Bucket::ForEachOverlap(const AABB& area, unsigned first, LayerMask mask, Visitor&& visitor) const
+{
+	if (!(layerUnion_ & mask))
+		return true;
+
+	return ForEachOverlap(area, first, [&](unsigned slot)
+	{
+		return !(layers_[slot] & mask) || Visit(visitor, slot);
+	});
+}
@@ -0,0 +1,398 @@
+﻿#pragma once
+/*******************************************************************************
+
+	@file BasicSpatialHashGrid.h
+
+	@date 10/17/2026 9:03:51 PM
+
+	@authors
+	Christian Wookey (christian.wookey@digipen.edu)
+
+	@brief
+	Uniform grid broadphase that hashes cells into an open addressed table.
+
+	@copyright All content © copyright 2020-2021, DigiPen (USA) Corporation 
+
+*******************************************************************************/
+
+#include "AABB.h"
+#include "OverlapKernel.h"
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <cmath>
+#include <unordered_map>
+#include <algorithm>
+#include <bit>
+#include <concepts>
+
+/// <summary>
+/// A spatial hash grid. Space is split into square cells of one size, and only the cells that
+/// hold objects are stored. They are found through an open addressed hash table with linear probing.
+/// Each cell keeps its objects' bounds packed in structure-of-arrays form, the same as a quadtree
+/// node. An object is stored in every cell its AABB touches. A pair is reported only from the cell
+/// holding the minimum corner of the two boxes' overlap, so nothing has to be deduplicated.
+/// Suited to dense scenes where objects are about the same size and spread fairly evenly. Use
+/// Quadtree when sizes or density vary a lot. BasicBroadphase can pick between them.
+/// T and BoundsFn work the same way as in BasicQuadtree. SpatialHashGrid is the version that stores GameObject pointers.
+/// </summary>
+template<typename T, typename BoundsFn>
+class BasicSpatialHashGrid
+{
+public:
+
+	/// <summary>
+	/// Two objects whose AABBs overlap.
+	/// </summary>
+	using ObjectPair = std::pair<T, T>;
+
+	/// <summary>
+	/// Default constructor.
+	/// </summary>
+	/// <returns>A new BasicSpatialHashGrid with the default settings</returns>
+	BasicSpatialHashGrid() : BasicSpatialHashGrid(1.f) {}
+
+	/// <summary>
+	/// Non-default constructor.
+	/// </summary>
+	/// <param name="cellSize">The width and height of a cell. About twice the size of a typical object works well.</param>
+	/// <param name="boundsFn">Reads the AABB of an item.</param>
+	/// <returns>A new BasicSpatialHashGrid with the specified cell size.</returns>
+	BasicSpatialHashGrid(float cellSize, BoundsFn boundsFn = BoundsFn());
+
+	/// destructor
+	~BasicSpatialHashGrid() = default;
+
+	BasicSpatialHashGrid(const BasicSpatialHashGrid&) = default;
+	BasicSpatialHashGrid& operator=(const BasicSpatialHashGrid&) = default;
+	/// <summary>
+	/// Move constructor. The other grid is left empty with the same cell size, so it can still be used.
+	/// </summary>
+	BasicSpatialHashGrid(BasicSpatialHashGrid&& other);
+
+	/// <summary>
+	/// Move assignment operator. Swaps the two grids, so the other grid is left holding this one's old contents.
+	/// </summary>
+	BasicSpatialHashGrid& operator=(BasicSpatialHashGrid&& other) noexcept;
+
+	/// <summary>
+	/// The most cells an object is stored in. Objects that would touch more are kept in a separate
+	/// list and tested against every query instead, so one huge object cannot fill the table.
+	/// </summary>
+	static constexpr unsigned MaxCellsPerObject = 64;
+
+	/// <summary>
+	/// Adds an object to the grid.
+	/// </summary>
+	/// <param name="object">The object to add.</param>
+	/// <returns>true if the object was added, false if it was already in the grid.</returns>
+	bool Insert(T object);
+
+	/// <summary>
+	/// Removes an object from the grid. Works even if the object moved since it was stored.
+	/// </summary>
+	/// <param name="object">The object to remove.</param>
+	/// <returns>true if the object was found and removed, false otherwise.</returns>
+	bool Remove(T object);
+
+	/// <summary>
+	/// Moves an object to match its current AABB. Only the cells it entered or left are changed
+	/// when the object still touches the same cells.
+	/// </summary>
+	/// <param name="object">The object that moved.</param>
+	/// <returns>true if the object was in the grid.</returns>
+	bool Update(T object);
+
+	/// <summary>
+	/// Removes every object and every cell.
+	/// </summary>
+	void Clear();
+
+	/// <summary>
+	/// Sets a new cell size. Every object is stored again.
+	/// </summary>
+	/// <param name="cellSize">The width and height of a cell. Must be greater than 0.</param>
+	void SetCellSize(float cellSize);
+
+	/// <summary>
+	/// Gets the width and height of a cell.
+	/// </summary>
+	/// <returns>The cell size.</returns>
+	float GetCellSize() const noexcept;
+
+	/// <summary>
+	/// Given an object, find all the objects in the grid that overlap its AABB.
+	/// Read only. Safe to call from many threads at once.
+	/// </summary>
+	/// <param name="object">The object to check</param>
+	/// <param name="collisionCandidates">A reference to a vector of T</param>
+	void GetCollisionCandidates(T object, _Inout_ std::vector<T>& collisionCandidates) const;
+
+	/// <summary>
+	/// Given an object, calls a visitor with each object in the grid that overlaps its AABB.
+	/// </summary>
+	/// <param name="object">The object to check</param>
+	/// <param name="visitor">Called as visitor(T) for each candidate. May return false to stop.</param>
+	/// <returns>false if the visitor stopped early.</returns>
+	template<typename Visitor> requires std::invocable<Visitor&, T>
+	bool GetCollisionCandidates(T object, Visitor&& visitor) const;
+
+	/// <summary>
+	/// Finds every object whose stored AABB overlaps an area.
+	/// </summary>
+	/// <param name="area">The area to search.</param>
+	/// <param name="results">The vector the objects are added to.</param>
+	void QueryRegion(const AABB& area, _Inout_ std::vector<T>& results) const;
+
+	/// <summary>
+	/// Calls a visitor with every object whose stored AABB overlaps an area, each object once.
+	/// </summary>
+	/// <param name="area">The area to search.</param>
+	/// <param name="visitor">Called as visitor(T) for each object. May return false to stop.</param>
+	/// <returns>false if the visitor stopped early.</returns>
+	template<typename Visitor> requires std::invocable<Visitor&, T>
+	bool QueryRegion(const AABB& area, Visitor&& visitor) const;
+
+	/// <summary>
+	/// Finds every pair of objects in the grid whose AABBs overlap, each pair exactly once.
+	/// </summary>
+	/// <param name="pairs">The vector the overlapping pairs are appended to.</param>
+	void FindAllPairs(_Inout_ std::vector<ObjectPair>& pairs) const;
+
+	/// <summary>
+	/// Counts the total number objects in the grid.
+	/// </summary>
+	/// <returns>the total number objects in the grid</returns>
+	unsigned GetTotalObjects() const noexcept;
+
+	/// <summary>
+	/// Counts the cells that are stored. Cells that were emptied are kept until the table fills up
+	/// while at least a quarter of its cells are empty, so objects moving back and forth do not keep
+	/// adding and removing them.
+	/// </summary>
+	/// <returns>The number of stored cells.</returns>
+	unsigned GetCellCount() const noexcept;
+
+private:
+
+	/// <summary>
+	/// The inclusive range of cell coordinates an AABB touches.
+	/// </summary>
+	struct CellRange
+	{
+		int minX;
+		int minY;
+		int maxX;
+		int maxY;
+
+		bool operator==(const CellRange&) const noexcept = default;
+	};
+
+	/// <summary>
+	/// Where an object was stored and the bounds it was stored with. oversized is the object's
+	/// index in oversized_, or NotOversized if it is stored in cells.
+	/// </summary>
+	struct Entry
+	{
+		AABB bounds;
+		CellRange cells;
+		unsigned oversized;
+	};
+
+	/// <summary>
+	/// The objects stored in one cell. Bounds are packed next to a parallel array of objects.
+	/// </summary>
+	struct Cell
+	{
+		int x;
+		int y;
+		std::vector<float> minX;
+		std::vector<float> minY;
+		std::vector<float> maxX;
+		std::vector<float> maxY;
+		std::vector<T> objects;
+	};
+
+	/// <summary>
+	/// One entry of the open addressed table: a packed cell coordinate and the index of the cell in cells_.
+	/// </summary>
+	struct Slot
+	{
+		uint64_t key;
+		unsigned cell;
+	};
+
+	/// <summary>
+	/// The value of Slot::cell for an unused slot.
+	/// </summary>
+	static constexpr unsigned EmptySlot = ~0u;
+
+	/// <summary>
+	/// The value of Entry::oversized for an object that is stored in cells.
+	/// </summary>
+	static constexpr unsigned NotOversized = ~0u;
+
+	/// <summary>
+	/// Cell coordinates are clamped to this, so huge or invalid bounds still map to a cell.
+	/// </summary>
+	static constexpr int MaxCellCoordinate = 1 << 30;
+
+	/// <summary>
+	/// The number of slots the table starts with. Always a power of 2.
+	/// </summary>
+	static constexpr unsigned InitialSlots = 64;
+
+	/// <summary>
+	/// Gets the current AABB of an item.
+	/// </summary>
+	AABB GetItemBounds(const T& object) const { return boundsFn_(object); }
+
+	/// <summary>
+	/// Finds the cell that holds one coordinate.
+	/// </summary>
+	/// <param name="value">An x or y coordinate.</param>
+	/// <returns>The cell coordinate, clamped to MaxCellCoordinate. NaN maps to the lowest cell.</returns>
+	int ToCell(float value) const noexcept;
+
+	/// <summary>
+	/// Finds the cells an AABB touches.
+	/// </summary>
+	CellRange GetCellRange(const AABB& bounds) const noexcept;
+
+	/// <summary>
+	/// Counts the cells in a range.
+	/// </summary>
+	static uint64_t CountCells(const CellRange& range) noexcept;
+
+	/// <summary>
+	/// Packs a cell coordinate into a table key.
+	/// </summary>
+	static uint64_t GetKey(int x, int y) noexcept;
+
+	/// <summary>
+	/// Gets the slot a key is probed from first.
+	/// </summary>
+	size_t GetHome(uint64_t key) const noexcept;
+
+	/// <summary>
+	/// Looks a cell up in the table.
+	/// </summary>
+	/// <returns>The index of the cell in cells_, or EmptySlot if no object was ever stored there.</returns>
+	unsigned FindCell(int x, int y) const noexcept;
+
+	/// <summary>
+	/// Looks a cell up in the table and adds it if it is not there. A full table keeps its size and
+	/// drops its empty cells if at least a quarter of them are empty, and doubles otherwise.
+	/// </summary>
+	/// <returns>The index of the cell in cells_.</returns>
+	unsigned FindOrAddCell(int x, int y);
+
+	/// <summary>
+	/// Rebuilds the table with a number of slots, dropping every empty cell.
+	/// </summary>
+	/// <param name="slotCount">The new number of slots. Must be a power of 2.</param>
+	void Rehash(size_t slotCount);
+
+	/// <summary>
+	/// Adds an object to every cell its entry's range covers, or to the oversized list if the range
+	/// is too big. Sets the entry's index in the oversized list.
+	/// </summary>
+	void Store(T object, Entry& entry);
+
+	/// <summary>
+	/// Removes an object from the cells or the oversized list its entry says it is in.
+	/// </summary>
+	void Unstore(T object, const Entry& entry);
+
+	/// <summary>
+	/// Finds the slot of an object in a cell.
+	/// </summary>
+	/// <returns>The slot, or the size of the cell if the object is not there.</returns>
+	static unsigned FindInCell(const Cell& cell, T object) noexcept;
+
+	/// <summary>
+	/// Does an object touch too many cells to be stored in them?
+	/// </summary>
+	static bool IsOversized(const CellRange& cells) noexcept;
+
+	/// <summary>
+	/// Checks if a cell is the one that reports an overlap: the cell holding the minimum corner of the
+	/// intersection of two boxes. Exactly one cell that both boxes touch passes.
+	/// </summary>
+	bool IsReportingCell(const Cell& cell, const AABB& a, float bMinX, float bMinY) const noexcept;
+
+	/// <summary>
+	/// Calls a visitor with every stored cell in a range. Walks every stored cell instead when the
+	/// range holds more cells than are stored.
+	/// </summary>
+	/// <param name="range">The cells to visit.</param>
+	/// <param name="visitor">Called as visitor(const Cell&) for each cell. May return false to stop.</param>
+	/// <returns>false if the visitor stopped early.</returns>
+	template<typename Visitor>
+	bool VisitCells(const CellRange& range, Visitor&& visitor) const;
+
+	/// <summary>
+	/// Calls a visitor with the slot of every object in a cell whose stored bounds overlap an area.
+	/// </summary>
+	/// <param name="cell">The cell to test.</param>
+	/// <param name="area">The area to test against.</param>
+	/// <param name="first">The first slot to test. Earlier slots are skipped.</param>
+	/// <param name="visitor">Called as visitor(unsigned slot) for each overlap. May return false to stop.</param>
+	/// <returns>false if the visitor stopped early.</returns>
+	template<typename Visitor>
+	static bool ForEachOverlap(const Cell& cell, const AABB& area, unsigned first, Visitor&& visitor);
+
+	/// <summary>
+	/// Calls a visitor that may or may not return a bool.
+	/// </summary>
+	/// <returns>What the visitor returned, or true if it returns nothing.</returns>
+	template<typename Visitor, typename... Args>
+	static bool Visit(Visitor& visitor, Args&&... args);
+
+	/// <summary>
+	/// The width and height of a cell.
+	/// </summary>
+	float cellSize_;
+
+	/// <summary>
+	/// 1 / cellSize_.
+	/// </summary>
+	float inverseCellSize_;
+
+	/// <summary>
+	/// log2 of the number of slots, so a hash can be reduced to a slot with a shift.
+	/// </summary>
+	unsigned slotBits_;
+
+	/// <summary>
+	/// How many cells in cells_ hold no objects. Decides whether a full table is compacted or doubled.
+	/// </summary>
+	size_t emptyCells_;
+
+	/// <summary>
+	/// Every stored cell. Each cell's objects are kept together in its own arrays.
+	/// </summary>
+	std::vector<Cell> cells_;
+
+	/// <summary>
+	/// The open addressed table from cell coordinate to index in cells_. At most half full.
+	/// </summary>
+	std::vector<Slot> slots_;
+
+	/// <summary>
+	/// The cells and bounds each object was stored with.
+	/// </summary>
+	std::unordered_map<T, Entry> entries_;
+
+	/// <summary>
+	/// Objects that touch more than MaxCellsPerObject cells.
+	/// </summary>
+	std::vector<T> oversized_;
+
+	/// <summary>
+	/// Reads the AABB of an item.
+	/// </summary>
+	[[no_unique_address]] BoundsFn boundsFn_;
+};
+
+#include "BasicSpatialHashGrid.inl"
@@ -0,0 +1,497 @@
+﻿#pragma once
+/*******************************************************************************
+
+	@file BasicSpatialHashGrid.inl
+
+	@date 10/17/2026 9:03:51 PM
+
+	@authors
+	Christian Wookey (christian.wookey@digipen.edu)
+
+	@brief
+	Uniform grid broadphase that hashes cells into an open addressed table.
+
+	@copyright All content © copyright 2020-2021, DigiPen (USA) Corporation 
+
+*******************************************************************************/
+
+/*****************************************************************************/
+/*                             PUBLIC FUNCTIONS                              */
+/*****************************************************************************/
+template<typename T, typename BoundsFn>
+BasicSpatialHashGrid<T, BoundsFn>::BasicSpatialHashGrid(float cellSize, BoundsFn boundsFn) : cellSize_(cellSize), inverseCellSize_(1.f / cellSize), slotBits_(std::countr_zero(InitialSlots)), emptyCells_(0), slots_(InitialSlots, Slot{ 0, EmptySlot }), boundsFn_(std::move(boundsFn))
+{
+}
+
+template<typename T, typename BoundsFn>
+BasicSpatialHashGrid<T, BoundsFn>::BasicSpatialHashGrid(BasicSpatialHashGrid&& other) : cellSize_(other.cellSize_), inverseCellSize_(other.inverseCellSize_), slotBits_(other.slotBits_), emptyCells_(other.emptyCells_), cells_(std::move(other.cells_)), slots_(std::move(other.slots_)), entries_(std::move(other.entries_)), oversized_(std::move(other.oversized_)), boundsFn_(other.boundsFn_)
+{
+	// the other grid gets a fresh table, so it can still be used
+	other.Clear();
+}
+
+template<typename T, typename BoundsFn>
+BasicSpatialHashGrid<T, BoundsFn>& BasicSpatialHashGrid<T, BoundsFn>::operator=(BasicSpatialHashGrid&& other) noexcept
+{
+	if (this != &other)
+	{
+		using std::swap;
+		swap(cellSize_, other.cellSize_);
+		swap(inverseCellSize_, other.inverseCellSize_);
+		swap(slotBits_, other.slotBits_);
+		swap(emptyCells_, other.emptyCells_);
+		swap(cells_, other.cells_);
+		swap(slots_, other.slots_);
+		swap(entries_, other.entries_);
+		swap(oversized_, other.oversized_);
+		swap(boundsFn_, other.boundsFn_);
+	}
+	return *this;
+}
+
+template<typename T, typename BoundsFn>
+bool BasicSpatialHashGrid<T, BoundsFn>::Insert(T object)
+{
+	const AABB bounds = GetItemBounds(object);
+	auto [entry, added] = entries_.emplace(object, Entry{ bounds, GetCellRange(bounds), NotOversized });
+	if (!added)
+		return false;
+
+	Store(object, entry->second);
+	return true;
+}
+
+template<typename T, typename BoundsFn>
+bool BasicSpatialHashGrid<T, BoundsFn>::Remove(T object)
+{
+	auto entry = entries_.find(object);
+	if (entry == entries_.end())
+		return false;
+
+	Unstore(object, entry->second);
+	entries_.erase(entry);
+	return true;
+}
+
+template<typename T, typename BoundsFn>
+bool BasicSpatialHashGrid<T, BoundsFn>::Update(T object)
+{
+	auto entry = entries_.find(object);
+	if (entry == entries_.end())
+		return false;
+
+	const AABB bounds = GetItemBounds(object);
+	const CellRange cells = GetCellRange(bounds);
+	Entry& stored = entry->second;
+
+	if (cells == stored.cells && !IsOversized(cells))
+	{
+		// same cells, so only the packed bounds change
+		for (int y = cells.minY; y <= cells.maxY; ++y)
+		{
+			for (int x = cells.minX; x <= cells.maxX; ++x)
+			{
+				Cell& cell = cells_[FindCell(x, y)];
+				const unsigned slot = FindInCell(cell, object);
+				cell.minX[slot] = bounds.Minimum().x;
+				cell.minY[slot] = bounds.Minimum().y;
+				cell.maxX[slot] = bounds.Maximum().x;
+				cell.maxY[slot] = bounds.Maximum().y;
+			}
+		}
+		stored.bounds = bounds;
+	}
+	else
+	{
+		Unstore(object, stored);
+		stored = Entry{ bounds, cells, NotOversized };
+		Store(object, stored);
+	}
+
+	return true;
+}
+
+template<typename T, typename BoundsFn>
+void BasicSpatialHashGrid<T, BoundsFn>::Clear()
+{
+	cells_.clear();
+	slots_.assign(InitialSlots, Slot{ 0, EmptySlot });
+	slotBits_ = std::countr_zero(InitialSlots);
+	emptyCells_ = 0;
+	entries_.clear();
+	oversized_.clear();
+}
+
+template<typename T, typename BoundsFn>
+void BasicSpatialHashGrid<T, BoundsFn>::SetCellSize(float cellSize)
+{
+	std::vector<std::pair<T, AABB>> objects;
+	objects.reserve(entries_.size());
+	for (const auto& [object, entry] : entries_)
+	{
+		objects.emplace_back(object, entry.bounds);
+	}
+
+	Clear();
+	cellSize_ = cellSize;
+	inverseCellSize_ = 1.f / cellSize;
+
+	for (const auto& [object, bounds] : objects)
+	{
+		Store(object, entries_.emplace(object, Entry{ bounds, GetCellRange(bounds), NotOversized }).first->second);
+	}
+}
+
+template<typename T, typename BoundsFn>
+float BasicSpatialHashGrid<T, BoundsFn>::GetCellSize() const noexcept
+{
+	return cellSize_;
+}
+
+template<typename T, typename BoundsFn>
+void BasicSpatialHashGrid<T, BoundsFn>::GetCollisionCandidates(T object, _Inout_ std::vector<T>& collisionCandidates) const
+{
+	GetCollisionCandidates(object, [&](T other) { collisionCandidates.push_back(other); });
+}
+
+template<typename T, typename BoundsFn>
+void BasicSpatialHashGrid<T, BoundsFn>::QueryRegion(const AABB& area, _Inout_ std::vector<T>& results) const
+{
+	QueryRegion(area, [&](T object) { results.push_back(object); });
+}
+
+template<typename T, typename BoundsFn>
+void BasicSpatialHashGrid<T, BoundsFn>::FindAllPairs(_Inout_ std::vector<ObjectPair>& pairs) const
+{
+	for (const Cell& cell : cells_)
+	{
+		const unsigned size = (unsigned)cell.objects.size();
+		for (unsigned i = 0; i < size; ++i)
+		{
+			const AABB bounds(cell.minX[i], cell.minY[i], cell.maxX[i], cell.maxY[i]);
+			ForEachOverlap(cell, bounds, i + 1, [&](unsigned slot)
+			{
+				if (IsReportingCell(cell, bounds, cell.minX[slot], cell.minY[slot]))
+					pairs.emplace_back(cell.objects[i], cell.objects[slot]);
+			});
+		}
+	}
+
+	// oversized objects are in no cell, so they are paired with everything by querying
+	for (unsigned i = 0; i < oversized_.size(); ++i)
+	{
+		const T object = oversized_[i];
+		const AABB& bounds = entries_.at(object).bounds;
+		QueryRegion(bounds, [&](T other)
+		{
+			// pairs of two oversized objects are only reported by the first of them
+			const unsigned position = entries_.at(other).oversized;
+			if (other != object && (position == NotOversized || position > i))
+				pairs.emplace_back(object, other);
+		});
+	}
+}
+
+template<typename T, typename BoundsFn>
+unsigned BasicSpatialHashGrid<T, BoundsFn>::GetTotalObjects() const noexcept
+{
+	return (unsigned)entries_.size();
+}
+
+template<typename T, typename BoundsFn>
+unsigned BasicSpatialHashGrid<T, BoundsFn>::GetCellCount() const noexcept
+{
+	return (unsigned)cells_.size();
+}
+
+/*****************************************************************************/
+/*                            PRIVATE FUNCTIONS                              */
+/*****************************************************************************/
+template<typename T, typename BoundsFn>
+int BasicSpatialHashGrid<T, BoundsFn>::ToCell(float value) const noexcept
+{
+	const float cell = std::floor(value * inverseCellSize_);
+	if (!(cell > (float)-MaxCellCoordinate))
+		return -MaxCellCoordinate;
+	if (cell > (float)MaxCellCoordinate)
+		return MaxCellCoordinate;
+	return (int)cell;
+}
+
+template<typename T, typename BoundsFn>
+typename BasicSpatialHashGrid<T, BoundsFn>::CellRange BasicSpatialHashGrid<T, BoundsFn>::GetCellRange(const AABB& bounds) const noexcept
+{
+	return CellRange{ ToCell(bounds.Minimum().x), ToCell(bounds.Minimum().y), ToCell(bounds.Maximum().x), ToCell(bounds.Maximum().y) };
+}
+
+template<typename T, typename BoundsFn>
+uint64_t BasicSpatialHashGrid<T, BoundsFn>::CountCells(const CellRange& range) noexcept
+{
+	if (range.maxX < range.minX || range.maxY < range.minY)
+		return 0;
+
+	return (uint64_t)((int64_t)range.maxX - range.minX + 1) * (uint64_t)((int64_t)range.maxY - range.minY + 1);
+}
+
+template<typename T, typename BoundsFn>
+uint64_t BasicSpatialHashGrid<T, BoundsFn>::GetKey(int x, int y) noexcept
+{
+	return ((uint64_t)(uint32_t)x << 32) | (uint32_t)y;
+}
+
+template<typename T, typename BoundsFn>
+size_t BasicSpatialHashGrid<T, BoundsFn>::GetHome(uint64_t key) const noexcept
+{
+	// Fibonacci hashing, the top bits of the product are well mixed even for neighbouring cells
+	return (size_t)((key * 0x9E3779B97F4A7C15ull) >> (64 - slotBits_));
+}
+
+template<typename T, typename BoundsFn>
+unsigned BasicSpatialHashGrid<T, BoundsFn>::FindCell(int x, int y) const noexcept
+{
+	const uint64_t key = GetKey(x, y);
+	const size_t mask = slots_.size() - 1;
+
+	for (size_t slot = GetHome(key); ; slot = (slot + 1) & mask)
+	{
+		const Slot& entry = slots_[slot];
+		if (entry.cell == EmptySlot || entry.key == key)
+			return entry.cell;
+	}
+}
+
+template<typename T, typename BoundsFn>
+unsigned BasicSpatialHashGrid<T, BoundsFn>::FindOrAddCell(int x, int y)
+{
+	const uint64_t key = GetKey(x, y);
+	const size_t mask = slots_.size() - 1;
+
+	size_t slot = GetHome(key);
+	for (; slots_[slot].cell != EmptySlot; slot = (slot + 1) & mask)
+	{
+		if (slots_[slot].key == key)
+			return slots_[slot].cell;
+	}
+
+	// keep the table at most half full so probes stay short. Dropping the empty cells only pays off
+	// when it frees a good share of them, otherwise the table fills up again straight away
+	if ((cells_.size() + 1) * 2 > slots_.size())
+	{
+		Rehash(emptyCells_ * 4 >= cells_.size() ? slots_.size() : slots_.size() * 2);
+		return FindOrAddCell(x, y);
+	}
+
+	slots_[slot] = Slot{ key, (unsigned)cells_.size() };
+	Cell& cell = cells_.emplace_back();
+	cell.x = x;
+	cell.y = y;
+	++emptyCells_;
+	return slots_[slot].cell;
+}
+
+template<typename T, typename BoundsFn>
+void BasicSpatialHashGrid<T, BoundsFn>::Rehash(size_t slotCount)
+{
+	std::erase_if(cells_, [](const Cell& cell) { return cell.objects.empty(); });
+	emptyCells_ = 0;
+
+	slots_.assign(slotCount, Slot{ 0, EmptySlot });
+	slotBits_ = std::countr_zero(slotCount);
+
+	const size_t mask = slotCount - 1;
+	for (unsigned index = 0; index < cells_.size(); ++index)
+	{
+		const uint64_t key = GetKey(cells_[index].x, cells_[index].y);
+		size_t slot = GetHome(key);
+		while (slots_[slot].cell != EmptySlot)
+		{
+			slot = (slot + 1) & mask;
+		}
+		slots_[slot] = Slot{ key, index };
+	}
+}
+
+template<typename T, typename BoundsFn>
+void BasicSpatialHashGrid<T, BoundsFn>::Store(T object, Entry& entry)
+{
+	const AABB& bounds = entry.bounds;
+	const CellRange& cells = entry.cells;
+	if (IsOversized(cells))
+	{
+		entry.oversized = (unsigned)oversized_.size();
+		oversized_.push_back(object);
+		return;
+	}
+
+	entry.oversized = NotOversized;
+	for (int y = cells.minY; y <= cells.maxY; ++y)
+	{
+		for (int x = cells.minX; x <= cells.maxX; ++x)
+		{
+			Cell& cell = cells_[FindOrAddCell(x, y)];
+			if (cell.objects.empty())
+				--emptyCells_;
+
+			cell.minX.push_back(bounds.Minimum().x);
+			cell.minY.push_back(bounds.Minimum().y);
+			cell.maxX.push_back(bounds.Maximum().x);
+			cell.maxY.push_back(bounds.Maximum().y);
+			cell.objects.push_back(object);
+		}
+	}
+}
+
+template<typename T, typename BoundsFn>
+void BasicSpatialHashGrid<T, BoundsFn>::Unstore(T object, const Entry& entry)
+{
+	// swap and pop, the object moved into the gap is told its new index
+	if (entry.oversized != NotOversized)
+	{
+		const T moved = oversized_.back();
+		oversized_[entry.oversized] = moved;
+		entries_.at(moved).oversized = entry.oversized;
+		oversized_.pop_back();
+		return;
+	}
+
+	const CellRange& cells = entry.cells;
+	for (int y = cells.minY; y <= cells.maxY; ++y)
+	{
+		for (int x = cells.minX; x <= cells.maxX; ++x)
+		{
+			// swap and pop, order inside a cell does not matter
+			Cell& cell = cells_[FindCell(x, y)];
+			const unsigned slot = FindInCell(cell, object);
+			cell.minX[slot] = cell.minX.back();
+			cell.minY[slot] = cell.minY.back();
+			cell.maxX[slot] = cell.maxX.back();
+			cell.maxY[slot] = cell.maxY.back();
+			cell.objects[slot] = cell.objects.back();
+			cell.minX.pop_back();
+			cell.minY.pop_back();
+			cell.maxX.pop_back();
+			cell.maxY.pop_back();
+			cell.objects.pop_back();
+			if (cell.objects.empty())
+				++emptyCells_;
+		}
+	}
+}
+
+template<typename T, typename BoundsFn>
+unsigned BasicSpatialHashGrid<T, BoundsFn>::FindInCell(const Cell& cell, T object) noexcept
+{
+	return (unsigned)(std::find(cell.objects.begin(), cell.objects.end(), object) - cell.objects.begin());
+}
+
+template<typename T, typename BoundsFn>
+bool BasicSpatialHashGrid<T, BoundsFn>::IsOversized(const CellRange& cells) noexcept
+{
+	return CountCells(cells) > MaxCellsPerObject;
+}
+
+template<typename T, typename BoundsFn>
+bool BasicSpatialHashGrid<T, BoundsFn>::IsReportingCell(const Cell& cell, const AABB& a, float bMinX, float bMinY) const noexcept
+{
+	return ToCell(std::max(a.Minimum().x, bMinX)) == cell.x && ToCell(std::max(a.Minimum().y, bMinY)) == cell.y;
+}
+
+/*****************************************************************************/
+/*                            TEMPLATE FUNCTIONS                             */
+/*****************************************************************************/
+template<typename T, typename BoundsFn>
+template<typename Visitor> requires std::invocable<Visitor&, T>
+bool BasicSpatialHashGrid<T, BoundsFn>::GetCollisionCandidates(T object, Visitor&& visitor) const
+{
+	return QueryRegion(GetItemBounds(object), [&](T other)
+	{
+		return other == object || Visit(visitor, other);
+	});
+}
+
+template<typename T, typename BoundsFn>
+template<typename Visitor> requires std::invocable<Visitor&, T>
+bool BasicSpatialHashGrid<T, BoundsFn>::QueryRegion(const AABB& area, Visitor&& visitor) const
+{
+	for (T object : oversized_)
+	{
+		if (entries_.at(object).bounds.Overlaps(area) && !Visit(visitor, object))
+			return false;
+	}
+
+	return VisitCells(GetCellRange(area), [&](const Cell& cell)
+	{
+		return ForEachOverlap(cell, area, 0, [&](unsigned slot)
+		{
+			// an object in several cells is only reported from one of them
+			return !IsReportingCell(cell, area, cell.minX[slot], cell.minY[slot]) || Visit(visitor, cell.objects[slot]);
+		});
+	});
+}
+
+template<typename T, typename BoundsFn>
+template<typename Visitor>
+bool BasicSpatialHashGrid<T, BoundsFn>::VisitCells(const CellRange& range, Visitor&& visitor) const
+{
+	if (CountCells(range) > cells_.size())
+	{
+		for (const Cell& cell : cells_)
+		{
+			if (cell.x >= range.minX && cell.x <= range.maxX && cell.y >= range.minY && cell.y <= range.maxY && !visitor(cell))
+				return false;
+		}
+		return true;
+	}
+
+	for (int y = range.minY; y <= range.maxY; ++y)
+	{
+		for (int x = range.minX; x <= range.maxX; ++x)
+		{
+			const unsigned index = FindCell(x, y);
+			if (index != EmptySlot && !visitor(cells_[index]))
+				return false;
+		}
+	}
+	return true;
+}
+
+template<typename T, typename BoundsFn>
+template<typename Visitor>
+bool BasicSpatialHashGrid<T, BoundsFn>::ForEachOverlap(const Cell& cell, const AABB& area, unsigned first, Visitor&& visitor)
+{
+	// hits are compacted into a stack buffer, so large cells are tested in chunks
+	constexpr unsigned ChunkSize = 256;
+	unsigned hits[ChunkSize];
+
+	const unsigned size = (unsigned)cell.objects.size();
+	for (; first < size; first += ChunkSize)
+	{
+		const unsigned count = std::min(ChunkSize, size - first);
+		const unsigned hitCount = BatchOverlaps(
+			cell.minX.data() + first, cell.minY.data() + first,
+			cell.maxX.data() + first, cell.maxY.data() + first,
+			count, area, hits);
+
+		for (unsigned h = 0; h < hitCount; ++h)
+		{
+			if (!Visit(visitor, first + hits[h]))
+				return false;
+		}
+	}
+	return true;
+}
+
+template<typename T, typename BoundsFn>
+template<typename Visitor, typename... Args>
+bool BasicSpatialHashGrid<T, BoundsFn>::Visit(Visitor& visitor, Args&&... args)
+{
+	if constexpr (std::is_void_v<std::invoke_result_t<Visitor&, Args...>>)
+	{
+		visitor(std::forward<Args>(args)...);
+		return true;
+	}
+	else
+	{
+		return static_cast<bool>(visitor(std::forward<Args>(args)...));
+	}
+}
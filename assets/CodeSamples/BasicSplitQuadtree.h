@@ -0,0 +1,182 @@
+﻿#pragma once
+/*******************************************************************************
+
+	@file BasicSplitQuadtree.h
+
+	@date 10/17/2026 5:03:19 PM
+
+	@authors
+	Christian Wookey (christian.wookey@digipen.edu)
+
+	@brief
+	Broadphase that keeps static and dynamic objects in separate trees.
+
+	@copyright All content © copyright 2020-2021, DigiPen (USA) Corporation 
+
+*******************************************************************************/
+
+#include "BasicQuadtree.h"
+#include "BasicLinearQuadtree.h"
+
+/// <summary>
+/// Keeps objects that never move apart from the ones that do. Static objects are bulk built into a
+/// read only BasicLinearQuadtree, which is a sorted array with no per node cost, and dynamic objects
+/// live in an incremental BasicQuadtree. Queries search both, and FindAllPairs never tests two static
+/// objects against each other.
+/// T and BoundsFn work the same way as in BasicQuadtree. SplitQuadtree is the version that stores GameObject pointers.
+/// </summary>
+template<typename T, typename BoundsFn>
+class BasicSplitQuadtree
+{
+public:
+
+	/// <summary>
+	/// Two objects whose AABBs overlap.
+	/// </summary>
+	using ObjectPair = std::pair<T, T>;
+
+	/// <summary>
+	/// Default constructor.
+	/// </summary>
+	/// <returns>A new BasicSplitQuadtree with the default settings</returns>
+	BasicSplitQuadtree() : BasicSplitQuadtree(AABB(-10.f, -10.f, 10.f, 10.f)) {}
+
+	/// <summary>
+	/// Non-default constructor.
+	/// </summary>
+	/// <param name="bounds">The area that the trees cover.</param>
+	/// <returns>A new BasicSplitQuadtree with the specified bounds</returns>
+	BasicSplitQuadtree(AABB bounds) : BasicSplitQuadtree(6, 8, bounds) {}
+
+	/// <summary>
+	/// Non-default constructor.
+	/// </summary>
+	/// <param name="maxDepth">Maximum depth of both trees.</param>
+	/// <param name="maxObjects">The maximum number of objects stored in one node of the dynamic tree.</param>
+	/// <param name="bounds">The area that the trees cover.</param>
+	/// <param name="boundsFn">Reads the AABB of an item.</param>
+	/// <returns>A new BasicSplitQuadtree with a specified bounds, max depth and max objects.</returns>
+	BasicSplitQuadtree(unsigned maxDepth, unsigned maxObjects, AABB bounds, BoundsFn boundsFn = BoundsFn());
+
+	/// destructor
+	~BasicSplitQuadtree() = default;
+
+	BasicSplitQuadtree(const BasicSplitQuadtree&) = default;
+	BasicSplitQuadtree& operator=(const BasicSplitQuadtree&) = default;
+
+	BasicSplitQuadtree(BasicSplitQuadtree&&) = default;
+	BasicSplitQuadtree& operator=(BasicSplitQuadtree&&) = default;
+
+	/// <summary>
+	/// Adds an object that never moves. It can be found by queries after the next BuildStatic().
+	/// </summary>
+	/// <param name="object">The object to add.</param>
+	/// <returns>true if the object was added, false if it was already in the static tree.</returns>
+	bool InsertStatic(T object);
+
+	/// <summary>
+	/// Removes an object that never moves. Queries stop returning it after the next BuildStatic().
+	/// </summary>
+	/// <param name="object">The object to remove.</param>
+	/// <returns>true if the object was found, false otherwise.</returns>
+	bool RemoveStatic(T object);
+
+	/// <summary>
+	/// Replaces every static object and builds the static tree.
+	/// </summary>
+	/// <param name="objects">The objects that never move. Every object must be unique.</param>
+	void BuildStatic(std::span<const T> objects);
+
+	/// <summary>
+	/// Builds the static tree if static objects were added or removed since it was last built.
+	/// </summary>
+	void BuildStatic();
+
+	/// <summary>
+	/// Adds an object that moves.
+	/// </summary>
+	/// <param name="object">The object to add.</param>
+	/// <returns>true if the object was inserted successfully, false otherwise.</returns>
+	bool Insert(T object);
+
+	/// <summary>
+	/// Removes an object that moves.
+	/// </summary>
+	/// <param name="object">The object to remove.</param>
+	/// <returns>true if the object was found and removed, false otherwise.</returns>
+	bool Remove(T object);
+
+	/// <summary>
+	/// Moves an object that moves to match its current AABB.
+	/// </summary>
+	/// <param name="object">The object that moved.</param>
+	/// <returns>true if the object was in the dynamic tree.</returns>
+	bool Update(T object);
+
+	/// <summary>
+	/// Removes every static and dynamic object.
+	/// </summary>
+	void Clear();
+
+	/// <summary>
+	/// Given an object, find all the static and dynamic objects that overlap its AABB.
+	/// </summary>
+	/// <param name="object">The object to check</param>
+	/// <param name="collisionCandidates">A reference to a vector of T</param>
+	void GetCollisionCandidates(T object, _Inout_ std::vector<T>& collisionCandidates) const;
+
+	/// <summary>
+	/// Finds every static and dynamic object whose AABB overlaps an area.
+	/// </summary>
+	/// <param name="area">The area to search.</param>
+	/// <param name="results">The vector the objects are added to.</param>
+	void QueryRegion(const AABB& area, _Inout_ std::vector<T>& results) const;
+
+	/// <summary>
+	/// Calls a visitor with every static and dynamic object whose AABB overlaps an area, without allocating.
+	/// </summary>
+	/// <param name="area">The area to search.</param>
+	/// <param name="visitor">Called as visitor(T) for each object. May return false to stop the search.</param>
+	/// <returns>false if the visitor stopped the search.</returns>
+	template<typename Visitor> requires std::invocable<Visitor&, T>
+	bool QueryRegion(const AABB& area, Visitor&& visitor) const;
+
+	/// <summary>
+	/// Finds every overlapping pair that has at least one dynamic object, each pair exactly once.
+	/// Static objects are never paired with each other. Builds the static tree first if needed.
+	/// </summary>
+	/// <param name="pairs">The vector the overlapping pairs are appended to.</param>
+	void FindAllPairs(_Inout_ std::vector<ObjectPair>& pairs);
+
+	/// <summary>
+	/// Gets the tree that holds the objects that move.
+	/// </summary>
+	/// <returns>The dynamic tree.</returns>
+	BasicQuadtree<T, BoundsFn>& GetDynamic() noexcept;
+
+	/// <summary>
+	/// Gets the tree that holds the objects that never move.
+	/// </summary>
+	/// <returns>The static tree.</returns>
+	const BasicLinearQuadtree<T, BoundsFn>& GetStatic() const noexcept;
+
+	/// <summary>
+	/// Counts the total number objects in both trees.
+	/// </summary>
+	/// <returns>the total number objects in both trees</returns>
+	unsigned GetTotalObjects() const noexcept;
+
+private:
+
+	/// <summary>
+	/// The objects that never move.
+	/// </summary>
+	BasicLinearQuadtree<T, BoundsFn> static_;
+
+	/// <summary>
+	/// The objects that move.
+	/// </summary>
+	BasicQuadtree<T, BoundsFn> dynamic_;
+};
+
+#include "BasicSplitQuadtree.inl"
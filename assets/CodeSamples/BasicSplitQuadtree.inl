@@ -0,0 +1,131 @@
+﻿#pragma once
+/*******************************************************************************
+
+	@file BasicSplitQuadtree.inl
+
+	@date 10/17/2026 5:03:19 PM
+
+	@authors
+	Christian Wookey (christian.wookey@digipen.edu)
+
+	@brief
+	Broadphase that keeps static and dynamic objects in separate trees.
+
+	@copyright All content © copyright 2020-2021, DigiPen (USA) Corporation 
+
+*******************************************************************************/
+
+/*****************************************************************************/
+/*                             PUBLIC FUNCTIONS                              */
+/*****************************************************************************/
+template<typename T, typename BoundsFn>
+BasicSplitQuadtree<T, BoundsFn>::BasicSplitQuadtree(unsigned maxDepth, unsigned maxObjects, AABB bounds, BoundsFn boundsFn) : static_(maxDepth, bounds, boundsFn), dynamic_(maxDepth, maxObjects, bounds, boundsFn)
+{
+}
+
+template<typename T, typename BoundsFn>
+bool BasicSplitQuadtree<T, BoundsFn>::InsertStatic(T object)
+{
+	return static_.Insert(object);
+}
+
+template<typename T, typename BoundsFn>
+bool BasicSplitQuadtree<T, BoundsFn>::RemoveStatic(T object)
+{
+	return static_.Remove(object);
+}
+
+template<typename T, typename BoundsFn>
+void BasicSplitQuadtree<T, BoundsFn>::BuildStatic(std::span<const T> objects)
+{
+	static_.BuildFrom(objects);
+}
+
+template<typename T, typename BoundsFn>
+void BasicSplitQuadtree<T, BoundsFn>::BuildStatic()
+{
+	if (static_.IsDirty())
+		static_.Build();
+}
+
+template<typename T, typename BoundsFn>
+bool BasicSplitQuadtree<T, BoundsFn>::Insert(T object)
+{
+	return dynamic_.Insert(object);
+}
+
+template<typename T, typename BoundsFn>
+bool BasicSplitQuadtree<T, BoundsFn>::Remove(T object)
+{
+	return dynamic_.Remove(object);
+}
+
+template<typename T, typename BoundsFn>
+bool BasicSplitQuadtree<T, BoundsFn>::Update(T object)
+{
+	return dynamic_.Update(object);
+}
+
+template<typename T, typename BoundsFn>
+void BasicSplitQuadtree<T, BoundsFn>::Clear()
+{
+	static_.Clear();
+	dynamic_.Clear();
+}
+
+template<typename T, typename BoundsFn>
+void BasicSplitQuadtree<T, BoundsFn>::GetCollisionCandidates(T object, _Inout_ std::vector<T>& collisionCandidates) const
+{
+	static_.GetCollisionCandidates(object, collisionCandidates);
+	dynamic_.GetCollisionCandidates(object, collisionCandidates);
+}
+
+template<typename T, typename BoundsFn>
+void BasicSplitQuadtree<T, BoundsFn>::QueryRegion(const AABB& area, _Inout_ std::vector<T>& results) const
+{
+	QueryRegion(area, [&](T object) { results.push_back(object); });
+}
+
+template<typename T, typename BoundsFn>
+void BasicSplitQuadtree<T, BoundsFn>::FindAllPairs(_Inout_ std::vector<ObjectPair>& pairs)
+{
+	BuildStatic();
+
+	dynamic_.FindAllPairs(pairs);
+
+	// each dynamic object against the static tree; static against static is never tested
+	dynamic_.ForEachObject([&](T object, const AABB& bounds)
+	{
+		static_.QueryRegion(bounds, [&](T other) { pairs.emplace_back(object, other); });
+	});
+}
+
+template<typename T, typename BoundsFn>
+BasicQuadtree<T, BoundsFn>& BasicSplitQuadtree<T, BoundsFn>::GetDynamic() noexcept
+{
+	return dynamic_;
+}
+
+template<typename T, typename BoundsFn>
+const BasicLinearQuadtree<T, BoundsFn>& BasicSplitQuadtree<T, BoundsFn>::GetStatic() const noexcept
+{
+	return static_;
+}
+
+template<typename T, typename BoundsFn>
+unsigned BasicSplitQuadtree<T, BoundsFn>::GetTotalObjects() const noexcept
+{
+	return static_.GetTotalObjects() + dynamic_.GetTotalObjects();
+}
+
+/*****************************************************************************/
+/*                            TEMPLATE FUNCTIONS                             */
+/*****************************************************************************/
+template<typename T, typename BoundsFn>
+template<typename Visitor> requires std::invocable<Visitor&, T>
+bool BasicSplitQuadtree<T, BoundsFn>::QueryRegion(const AABB& area, Visitor&& visitor) const
+{
+	if (!static_.QueryRegion(area, visitor))
+		return false;
+	return dynamic_.QueryRegion(area, visitor);
+}
@@ -0,0 +1,120 @@
+﻿#pragma once
+#include "stdafx.h"
+/*******************************************************************************
+
+	@file Broadphase.cpp
+
+	@date 10/17/2026 9:41:18 PM
+
+	@authors
+	Christian Wookey (christian.wookey@digipen.edu)
+
+	@brief
+	Picks a quadtree or spatial hash grid for a scene and hides which one it picked.
+
+	@copyright All content © copyright 2020-2021, DigiPen (USA) Corporation 
+
+*******************************************************************************/
+
+#include "Broadphase.h"
+#include <cmath>
+
+template class BasicBroadphase<GameObject*, GameObjectBounds>;
+
+/// <summary>
+/// Below this many objects every broadphase is fast, so the quadtree is kept.
+/// </summary>
+static constexpr unsigned MinGridObjects = 256;
+
+/// <summary>
+/// The largest ratio of large to median object size a grid is picked for. Cells are sized for
+/// the median object, so large objects would be stored in many cells.
+/// </summary>
+static constexpr float MaxGridSizeSpread = 4.f;
+
+/// <summary>
+/// The most clustered a scene can be for a grid to be picked. Crowded cells are tested object
+/// by object, where a quadtree would keep splitting them.
+/// </summary>
+static constexpr float MaxGridClustering = 1.f;
+
+SceneDensity MeasureDensity(std::span<const AABB> bounds)
+{
+	SceneDensity density;
+	density.objectCount = (unsigned)bounds.size();
+	if (bounds.empty())
+		return density;
+
+	float minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX;
+	std::vector<float> sizes;
+	sizes.reserve(bounds.size());
+	for (const AABB& box : bounds)
+	{
+		minX = std::min(minX, box.Minimum().x);
+		minY = std::min(minY, box.Minimum().y);
+		maxX = std::max(maxX, box.Maximum().x);
+		maxY = std::max(maxY, box.Maximum().y);
+		sizes.push_back(std::max(box.Maximum().x - box.Minimum().x, box.Maximum().y - box.Minimum().y));
+	}
+	density.extent = AABB(minX, minY, maxX, maxY);
+
+	auto median = sizes.begin() + sizes.size() / 2;
+	std::nth_element(sizes.begin(), median, sizes.end());
+	density.medianSize = *median;
+
+	auto large = sizes.begin() + sizes.size() * 9 / 10;
+	std::nth_element(sizes.begin(), large, sizes.end());
+	density.largeSize = *large;
+
+	// bin the centers into a coarse grid with about 4 objects per bin if they were spread evenly
+	const unsigned side = std::max(1u, (unsigned)std::sqrt(bounds.size() / 4.f));
+	const float width = std::max(maxX - minX, FLT_MIN);
+	const float height = std::max(maxY - minY, FLT_MIN);
+	std::vector<unsigned> bins(side * side, 0);
+	for (const AABB& box : bounds)
+	{
+		const DirectX::SimpleMath::Vector2 center = box.Center();
+		const unsigned x = std::min(side - 1, (unsigned)((center.x - minX) / width * side));
+		const unsigned y = std::min(side - 1, (unsigned)((center.y - minY) / height * side));
+		bins[y * side + x]++;
+	}
+
+	const float mean = (float)bounds.size() / bins.size();
+	float variance = 0.f;
+	for (unsigned count : bins)
+	{
+		variance += (count - mean) * (count - mean);
+	}
+	density.clustering = std::sqrt(variance / bins.size()) / mean;
+
+	return density;
+}
+
+BroadphaseBackend ChooseBackend(const SceneDensity& density) noexcept
+{
+	if (density.objectCount < MinGridObjects || !(density.medianSize > 0.f))
+		return BroadphaseBackend::Quadtree;
+
+	if (density.largeSize > density.medianSize * MaxGridSizeSpread)
+		return BroadphaseBackend::Quadtree;
+
+	if (density.clustering > MaxGridClustering)
+		return BroadphaseBackend::Quadtree;
+
+	return BroadphaseBackend::SpatialHashGrid;
+}
+
+float SuggestCellSize(const SceneDensity& density) noexcept
+{
+	if (density.medianSize > 0.f)
+		return density.medianSize * 2.f;
+
+	// every object is a point, so aim for about 4 objects per cell instead
+	const float width = density.extent.Maximum().x - density.extent.Minimum().x;
+	const float height = density.extent.Maximum().y - density.extent.Minimum().y;
+	const float area = width * height;
+	if (density.objectCount && area > 0.f)
+		return std::sqrt(area * 4.f / density.objectCount);
+
+	return 1.f;
+}
@@ -0,0 +1,28 @@
+﻿#pragma once
+/*******************************************************************************
+
+	@file Broadphase.h
+
+	@date 10/17/2026 9:41:18 PM
+
+	@authors
+	Christian Wookey (christian.wookey@digipen.edu)
+
+	@brief
+	Picks a quadtree or spatial hash grid for a scene and hides which one it picked.
+
+	@copyright All content © copyright 2020-2021, DigiPen (USA) Corporation 
+
+*******************************************************************************/
+
+#include "BasicBroadphase.h"
+#include "Quadtree.h"
+#include "SpatialHashGrid.h"
+
+/// <summary>
+/// The broadphase used by the engine, which stores GameObject pointers.
+/// </summary>
+using Broadphase = BasicBroadphase<GameObject*, GameObjectBounds>;
+
+// compiled once in Broadphase.cpp
+extern template class BasicBroadphase<GameObject*, GameObjectBounds>;
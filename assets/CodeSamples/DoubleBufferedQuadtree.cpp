@@ -0,0 +1,21 @@
+﻿#pragma once
+#include "stdafx.h"
+/*******************************************************************************
+
+	@file DoubleBufferedQuadtree.cpp
+
+	@date 10/17/2026 8:12:40 PM
+
+	@authors
+	Christian Wookey (christian.wookey@digipen.edu)
+
+	@brief
+	Two quadtrees, one read by this frame while the next frame's is built.
+
+	@copyright All content © copyright 2020-2021, DigiPen (USA) Corporation 
+
+*******************************************************************************/
+
+#include "DoubleBufferedQuadtree.h"
+
+template class BasicDoubleBufferedQuadtree<GameObject*, GameObjectBounds>;
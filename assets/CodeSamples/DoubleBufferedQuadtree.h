@@ -0,0 +1,27 @@
+﻿#pragma once
+/*******************************************************************************
+
+	@file DoubleBufferedQuadtree.h
+
+	@date 10/17/2026 8:12:40 PM
+
+	@authors
+	Christian Wookey (christian.wookey@digipen.edu)
+
+	@brief
+	Two quadtrees, one read by this frame while the next frame's is built.
+
+	@copyright All content © copyright 2020-2021, DigiPen (USA) Corporation 
+
+*******************************************************************************/
+
+#include "BasicDoubleBufferedQuadtree.h"
+#include "GameObjectBounds.h"
+
+/// <summary>
+/// The double buffered quadtree used by the engine, which stores GameObject pointers.
+/// </summary>
+using DoubleBufferedQuadtree = BasicDoubleBufferedQuadtree<GameObject*, GameObjectBounds>;
+
+// compiled once in DoubleBufferedQuadtree.cpp
+extern template class BasicDoubleBufferedQuadtree<GameObject*, GameObjectBounds>;
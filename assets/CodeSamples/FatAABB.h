@@ -0,0 +1,58 @@
+﻿#pragma once
+/*******************************************************************************
+
+	@file FatAABB.h
+
+	@date 10/17/2026 9:48:15 PM
+
+	@authors
+	Christian Wookey (christian.wookey@digipen.edu)
+
+	@brief
+	Small AABB helpers shared by the structures that store fat AABBs.
+
+	@copyright All content © copyright 2020-2021, DigiPen (USA) Corporation 
+
+*******************************************************************************/
+
+#include "AABB.h"
+#include <algorithm>
+#include <cmath>
+
+/// <summary>
+/// Makes a fat AABB, grown by a margin on every side and stretched along a displacement.
+/// The stretch only goes the way the object is heading, the trailing side keeps the plain margin.
+/// </summary>
+/// <param name="bounds">The AABB to grow.</param>
+/// <param name="margin">How far to push out every side.</param>
+/// <param name="stretch">How far to push out the sides facing along it.</param>
+/// <returns>The fat AABB.</returns>
+inline AABB FattenAABB(const AABB& bounds, float margin, const DirectX::SimpleMath::Vector2& stretch = DirectX::SimpleMath::Vector2()) noexcept
+{
+	return AABB(
+		bounds.Minimum().x - margin + std::min(stretch.x, 0.f), bounds.Minimum().y - margin + std::min(stretch.y, 0.f),
+		bounds.Maximum().x + margin + std::max(stretch.x, 0.f), bounds.Maximum().y + margin + std::max(stretch.y, 0.f));
+}
+
+/// <summary>
+/// Checks if one AABB is completely inside another. Touching edges count as inside.
+/// </summary>
+/// <param name="outer">The AABB that should contain inner.</param>
+/// <param name="inner">The AABB to check.</param>
+/// <returns>true if inner is inside outer.</returns>
+inline bool ContainsAABB(const AABB& outer, const AABB& inner) noexcept
+{
+	return outer.Minimum().x <= inner.Minimum().x && outer.Minimum().y <= inner.Minimum().y &&
+		inner.Maximum().x <= outer.Maximum().x && inner.Maximum().y <= outer.Maximum().y;
+}
+
+/// <summary>
+/// Checks that none of an AABB's coordinates are NaN or infinite.
+/// </summary>
+/// <param name="bounds">The AABB to check.</param>
+/// <returns>true if every coordinate is finite.</returns>
+inline bool IsFiniteAABB(const AABB& bounds) noexcept
+{
+	return std::isfinite(bounds.Minimum().x) && std::isfinite(bounds.Minimum().y) &&
+		std::isfinite(bounds.Maximum().x) && std::isfinite(bounds.Maximum().y);
+}
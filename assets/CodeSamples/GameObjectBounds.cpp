@@ -0,0 +1,25 @@
+﻿#pragma once
+#include "stdafx.h"
+/*******************************************************************************
+
+	@file GameObjectBounds.cpp
+
+	@date 10/17/2026 4:12:37 PM
+
+	@authors
+	Christian Wookey (christian.wookey@digipen.edu)
+
+	@brief
+	Reads the AABB of a GameObject for the spatial structures.
+
+	@copyright All content © copyright 2020-2021, DigiPen (USA) Corporation 
+
+*******************************************************************************/
+
+#include "GameObjectBounds.h"
+#include "GameObject.h"
+
+AABB GameObjectBounds::operator()(_In_ GameObject* object) const noexcept
+{
+	return object->GetAABB();
+}
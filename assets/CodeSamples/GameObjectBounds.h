@@ -0,0 +1,33 @@
+﻿#pragma once
+/*******************************************************************************
+
+	@file GameObjectBounds.h
+
+	@date 10/17/2026 4:12:37 PM
+
+	@authors
+	Christian Wookey (christian.wookey@digipen.edu)
+
+	@brief
+	Reads the AABB of a GameObject for the spatial structures.
+
+	@copyright All content © copyright 2020-2021, DigiPen (USA) Corporation 
+
+*******************************************************************************/
+
+#include "AABB.h"
+
+typedef class GameObject GameObject;
+
+/// <summary>
+/// Bounds accessor used to store GameObjects in a BasicQuadtree or BasicLinearQuadtree.
+/// </summary>
+struct GameObjectBounds
+{
+	/// <summary>
+	/// Gets the AABB of a GameObject.
+	/// </summary>
+	/// <param name="object">A pointer to the GameObject.</param>
+	/// <returns>The GameObject's AABB.</returns>
+	AABB operator()(_In_ GameObject* object) const noexcept;
+};
@@ -0,0 +1,21 @@
+﻿#pragma once
+#include "stdafx.h"
+/*******************************************************************************
+
+	@file LinearQuadtree.cpp
+
+	@date 10/17/2026 2:41:08 PM
+
+	@authors
+	Christian Wookey (christian.wookey@digipen.edu)
+
+	@brief
+	Pointerless quadtree that is rebuilt from scratch by sorting Morton codes.
+
+	@copyright All content © copyright 2020-2021, DigiPen (USA) Corporation 
+
+*******************************************************************************/
+
+#include "LinearQuadtree.h"
+
+template class BasicLinearQuadtree<GameObject*, GameObjectBounds>;
@@ -0,0 +1,27 @@
+﻿#pragma once
+/*******************************************************************************
+
+	@file LinearQuadtree.h
+
+	@date 10/17/2026 2:41:08 PM
+
+	@authors
+	Christian Wookey (christian.wookey@digipen.edu)
+
+	@brief
+	Pointerless quadtree that is rebuilt from scratch by sorting Morton codes.
+
+	@copyright All content © copyright 2020-2021, DigiPen (USA) Corporation 
+
+*******************************************************************************/
+
+#include "BasicLinearQuadtree.h"
+#include "GameObjectBounds.h"
+
+/// <summary>
+/// The linear quadtree used by the engine, which stores GameObject pointers.
+/// </summary>
+using LinearQuadtree = BasicLinearQuadtree<GameObject*, GameObjectBounds>;
+
+// compiled once in LinearQuadtree.cpp
+extern template class BasicLinearQuadtree<GameObject*, GameObjectBounds>;
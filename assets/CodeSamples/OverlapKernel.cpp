@@ -0,0 +1,127 @@
+﻿#include "stdafx.h"
+/*******************************************************************************
+
+	@file OverlapKernel.cpp
+
+	@date 10/17/2026 10:12:31 AM
+
+	@authors
+	Christian Wookey (christian.wookey@digipen.edu)
+
+	@brief
+	Tests one AABB against many packed AABBs at once using SIMD.
+
+	@copyright All content © copyright 2020-2021, DigiPen (USA) Corporation 
+
+*******************************************************************************/
+
+#include "OverlapKernel.h"
+#include <bit>
+
+#if defined(__AVX512F__)
+#define OVERLAP_KERNEL_AVX512
+#include <immintrin.h>
+#elif defined(__AVX2__)
+#define OVERLAP_KERNEL_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define OVERLAP_KERNEL_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(OVERLAP_KERNEL_AVX512)
+const unsigned OverlapBatchWidth = 16;
+#elif defined(OVERLAP_KERNEL_AVX2)
+const unsigned OverlapBatchWidth = 8;
+#elif defined(OVERLAP_KERNEL_SSE2)
+const unsigned OverlapBatchWidth = 4;
+#else
+const unsigned OverlapBatchWidth = 1;
+#endif
+
+/// <summary>
+/// Writes the index of every set bit in a lane mask to hits.
+/// </summary>
+/// <param name="mask">One bit per lane, set if that lane overlapped.</param>
+/// <param name="base">The index of lane 0.</param>
+/// <param name="hits">The output array.</param>
+/// <param name="hitCount">The number of entries already in hits. Updated.</param>
+static inline void CompactMask(unsigned mask, unsigned base, _Out_ unsigned* hits, unsigned& hitCount) noexcept
+{
+	while (mask != 0)
+	{
+		hits[hitCount++] = base + (unsigned)std::countr_zero(mask);
+		mask &= mask - 1;
+	}
+}
+
+unsigned BatchOverlaps(
+	_In_ const float* minX, _In_ const float* minY,
+	_In_ const float* maxX, _In_ const float* maxY,
+	unsigned count, const AABB& query, _Out_ unsigned* hits) noexcept
+{
+	const float queryMinX = query.Minimum().x;
+	const float queryMinY = query.Minimum().y;
+	const float queryMaxX = query.Maximum().x;
+	const float queryMaxY = query.Maximum().y;
+
+	unsigned hitCount = 0;
+	unsigned i = 0;
+
+#if defined(OVERLAP_KERNEL_AVX512)
+	const __m512 qMinX = _mm512_set1_ps(queryMinX);
+	const __m512 qMinY = _mm512_set1_ps(queryMinY);
+	const __m512 qMaxX = _mm512_set1_ps(queryMaxX);
+	const __m512 qMaxY = _mm512_set1_ps(queryMaxY);
+	for (; i + 16 <= count; i += 16)
+	{
+		__mmask16 mask = _mm512_cmp_ps_mask(_mm512_loadu_ps(minX + i), qMaxX, _CMP_LE_OQ);
+		mask = _mm512_mask_cmp_ps_mask(mask, qMinX, _mm512_loadu_ps(maxX + i), _CMP_LE_OQ);
+		mask = _mm512_mask_cmp_ps_mask(mask, _mm512_loadu_ps(minY + i), qMaxY, _CMP_LE_OQ);
+		mask = _mm512_mask_cmp_ps_mask(mask, qMinY, _mm512_loadu_ps(maxY + i), _CMP_LE_OQ);
+		CompactMask((unsigned)mask, i, hits, hitCount);
+	}
+#elif defined(OVERLAP_KERNEL_AVX2)
+	const __m256 qMinX = _mm256_set1_ps(queryMinX);
+	const __m256 qMinY = _mm256_set1_ps(queryMinY);
+	const __m256 qMaxX = _mm256_set1_ps(queryMaxX);
+	const __m256 qMaxY = _mm256_set1_ps(queryMaxY);
+	for (; i + 8 <= count; i += 8)
+	{
+		const __m256 x = _mm256_and_ps(
+			_mm256_cmp_ps(_mm256_loadu_ps(minX + i), qMaxX, _CMP_LE_OQ),
+			_mm256_cmp_ps(qMinX, _mm256_loadu_ps(maxX + i), _CMP_LE_OQ));
+		const __m256 y = _mm256_and_ps(
+			_mm256_cmp_ps(_mm256_loadu_ps(minY + i), qMaxY, _CMP_LE_OQ),
+			_mm256_cmp_ps(qMinY, _mm256_loadu_ps(maxY + i), _CMP_LE_OQ));
+		CompactMask((unsigned)_mm256_movemask_ps(_mm256_and_ps(x, y)), i, hits, hitCount);
+	}
+#elif defined(OVERLAP_KERNEL_SSE2)
+	const __m128 qMinX = _mm_set1_ps(queryMinX);
+	const __m128 qMinY = _mm_set1_ps(queryMinY);
+	const __m128 qMaxX = _mm_set1_ps(queryMaxX);
+	const __m128 qMaxY = _mm_set1_ps(queryMaxY);
+	for (; i + 4 <= count; i += 4)
+	{
+		const __m128 x = _mm_and_ps(
+			_mm_cmple_ps(_mm_loadu_ps(minX + i), qMaxX),
+			_mm_cmple_ps(qMinX, _mm_loadu_ps(maxX + i)));
+		const __m128 y = _mm_and_ps(
+			_mm_cmple_ps(_mm_loadu_ps(minY + i), qMaxY),
+			_mm_cmple_ps(qMinY, _mm_loadu_ps(maxY + i)));
+		CompactMask((unsigned)_mm_movemask_ps(_mm_and_ps(x, y)), i, hits, hitCount);
+	}
+#endif
+
+	// scalar fallback and the remainder of the vector loops
+	for (; i < count; ++i)
+	{
+		if (minX[i] <= queryMaxX && queryMinX <= maxX[i] &&
+			minY[i] <= queryMaxY && queryMinY <= maxY[i])
+		{
+			hits[hitCount++] = i;
+		}
+	}
+
+	return hitCount;
+}
@@ -0,0 +1,42 @@
+﻿#pragma once
+/*******************************************************************************
+
+	@file OverlapKernel.h
+
+	@date 10/17/2026 10:12:31 AM
+
+	@authors
+	Christian Wookey (christian.wookey@digipen.edu)
+
+	@brief
+	Tests one AABB against many packed AABBs at once using SIMD.
+
+	@copyright All content © copyright 2020-2021, DigiPen (USA) Corporation 
+
+*******************************************************************************/
+
+#include "AABB.h"
+
+/// <summary>
+/// The number of boxes the widest available kernel tests per instruction.
+/// 16 with AVX-512, 8 with AVX2, 4 with SSE2 and 1 for the scalar fallback.
+/// </summary>
+extern const unsigned OverlapBatchWidth;
+
+/// <summary>
+/// Tests a query box against a batch of boxes stored in structure-of-arrays form.
+/// Uses AVX-512, AVX2 or SSE2 when the compiler targets them and falls back to scalar code.
+/// Touching edges count as overlapping, the same as AABB::Overlaps.
+/// </summary>
+/// <param name="minX">The minimum x of each box.</param>
+/// <param name="minY">The minimum y of each box.</param>
+/// <param name="maxX">The maximum x of each box.</param>
+/// <param name="maxY">The maximum y of each box.</param>
+/// <param name="count">The number of boxes in the batch.</param>
+/// <param name="query">The box to test against.</param>
+/// <param name="hits">Receives the indices of the overlapping boxes, compacted. Must hold count entries.</param>
+/// <returns>The number of indices written to hits.</returns>
+unsigned BatchOverlaps(
+	_In_ const float* minX, _In_ const float* minY,
+	_In_ const float* maxX, _In_ const float* maxY,
+	unsigned count, const AABB& query, _Out_ unsigned* hits) noexcept;
@@ -0,0 +1,21 @@
+﻿#pragma once
+#include "stdafx.h"
+/*******************************************************************************
+
+	@file PairCache.cpp
+
+	@date 10/17/2026 6:41:52 PM
+
+	@authors
+	Christian Wookey (christian.wookey@digipen.edu)
+
+	@brief
+	Keeps overlapping pairs between frames and reports when they begin and end.
+
+	@copyright All content © copyright 2020-2021, DigiPen (USA) Corporation 
+
+*******************************************************************************/
+
+#include "PairCache.h"
+
+template class BasicPairCache<GameObject*, GameObjectBounds>;
@@ -0,0 +1,27 @@
+﻿#pragma once
+/*******************************************************************************
+
+	@file PairCache.h
+
+	@date 10/17/2026 6:41:52 PM
+
+	@authors
+	Christian Wookey (christian.wookey@digipen.edu)
+
+	@brief
+	Keeps overlapping pairs between frames and reports when they begin and end.
+
+	@copyright All content © copyright 2020-2021, DigiPen (USA) Corporation 
+
+*******************************************************************************/
+
+#include "BasicPairCache.h"
+#include "GameObjectBounds.h"
+
+/// <summary>
+/// The pair cache used by the engine, which stores GameObject pointers.
+/// </summary>
+using PairCache = BasicPairCache<GameObject*, GameObjectBounds>;
+
+// compiled once in PairCache.cpp
+extern template class BasicPairCache<GameObject*, GameObjectBounds>;
@@ -0,0 +1,577 @@
+﻿/*******************************************************************************
+
+	@file QuadtreeBenchmark.cpp
+
+	@date 10/17/2026 7:26:05 PM
+
+	@authors
+	Christian Wookey (christian.wookey@digipen.edu)
+
+	@brief
+	Headless benchmark and stress test for BasicQuadtree. Builds synthetic scenes
+	and times every operation, then checks the results against brute force.
+	Built as its own console program from this file and OverlapKernel.cpp, without
+	DirectX rendering or ImGui. It still needs from the engine:
+	- AABB.h, and DirectX SimpleMath for the Vector2 the tree uses
+	- stdafx.h, which OverlapKernel.cpp includes. An empty one is enough
+	BuildFrom uses std::execution::par, so with libstdc++ it also has to be linked
+	against TBB (-ltbb).
+	Usage: QuadtreeBenchmark [largest scene size, default 1000000]
+
+	@copyright All content © copyright 2020-2021, DigiPen (USA) Corporation 
+
+*******************************************************************************/
+
+#include "BasicQuadtree.h"
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <numeric>
+#include <random>
+
+/*****************************************************************************/
+/*                            ALLOCATION COUNTING                            */
+/*****************************************************************************/
+
+/// <summary>
+/// The number of calls to operator new since the program started. Over-aligned allocations are
+/// not counted, nothing in the tree needs them.
+/// </summary>
+static std::atomic<size_t> allocationCount = 0;
+
+void* operator new(size_t size)
+{
+	++allocationCount;
+	if (void* memory = std::malloc(size ? size : 1))
+		return memory;
+	throw std::bad_alloc();
+}
+
+void* operator new[](size_t size)
+{
+	return operator new(size);
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, size_t) noexcept { std::free(memory); }
+
+/*****************************************************************************/
+/*                                  SCENES                                   */
+/*****************************************************************************/
+
+/// <summary>
+/// The layouts the benchmark builds.
+/// </summary>
+enum class SceneType
+{
+	Uniform,     // small objects spread evenly
+	Clustered,   // small objects packed around a few points
+	LargeObjects,// one object in ten covers a large part of the world
+	CenterLines  // every object straddles one of the lines the tree splits on
+};
+
+/// <summary>
+/// The AABBs of every object in a scene. Objects are indices into bounds.
+/// </summary>
+struct Scene
+{
+	const char* name;
+	AABB world;
+	std::vector<AABB> bounds;
+};
+
+/// <summary>
+/// Reads the AABB of an object in a Scene.
+/// </summary>
+struct SceneBounds
+{
+	const Scene* scene;
+	AABB operator()(unsigned object) const { return scene->bounds[object]; }
+};
+
+using BenchmarkTree = BasicQuadtree<unsigned, SceneBounds>;
+
+/// <summary>
+/// Builds a scene. The world grows with the number of objects so the density stays the same.
+/// </summary>
+/// <param name="type">The layout to build.</param>
+/// <param name="count">The number of objects.</param>
+/// <param name="rng">The random number generator.</param>
+/// <returns>The scene.</returns>
+static Scene MakeScene(SceneType type, unsigned count, std::mt19937& rng)
+{
+	const float half = 4.f * std::sqrt(static_cast<float>(count));
+	std::uniform_real_distribution<float> position(-half, half), size(0.25f, 2.f);
+
+	Scene scene{ "", AABB(-half, -half, half, half), {} };
+	scene.bounds.reserve(count);
+
+	auto box = [](float x, float y, float w, float h) { return AABB(x - w, y - h, x + w, y + h); };
+
+	switch (type)
+	{
+	case SceneType::Uniform:
+		scene.name = "uniform";
+		for (unsigned i = 0; i < count; ++i)
+			scene.bounds.push_back(box(position(rng), position(rng), size(rng), size(rng)));
+		break;
+
+	case SceneType::Clustered:
+	{
+		scene.name = "clustered";
+		std::vector<DirectX::SimpleMath::Vector2> centers(std::max(1u, count / 1000));
+		for (DirectX::SimpleMath::Vector2& center : centers)
+			center = DirectX::SimpleMath::Vector2(position(rng) * 0.9f, position(rng) * 0.9f);
+
+		std::normal_distribution<float> spread(0.f, half * 0.02f);
+		std::uniform_int_distribution<size_t> pick(0, centers.size() - 1);
+		for (unsigned i = 0; i < count; ++i)
+		{
+			const DirectX::SimpleMath::Vector2& center = centers[pick(rng)];
+			scene.bounds.push_back(box(center.x + spread(rng), center.y + spread(rng), size(rng), size(rng)));
+		}
+		break;
+	}
+
+	case SceneType::LargeObjects:
+	{
+		scene.name = "large";
+		std::uniform_real_distribution<float> large(half * 0.02f, half * 0.2f);
+		for (unsigned i = 0; i < count; ++i)
+		{
+			if (i % 10 == 0)
+				scene.bounds.push_back(box(position(rng), position(rng), large(rng), large(rng)));
+			else
+				scene.bounds.push_back(box(position(rng), position(rng), size(rng), size(rng)));
+		}
+		break;
+	}
+
+	case SceneType::CenterLines:
+	{
+		scene.name = "centerlines";
+		// the split lines of the first three levels sit on multiples of half / 4
+		std::uniform_int_distribution<int> line(-3, 3);
+		for (unsigned i = 0; i < count; ++i)
+		{
+			const float onLine = line(rng) * half / 4.f;
+			if (i % 2)
+				scene.bounds.push_back(box(onLine, position(rng), size(rng), size(rng)));
+			else
+				scene.bounds.push_back(box(position(rng), onLine, size(rng), size(rng)));
+		}
+		break;
+	}
+	}
+
+	return scene;
+}
+
+/*****************************************************************************/
+/*                                  TIMING                                   */
+/*****************************************************************************/
+
+using Clock = std::chrono::steady_clock;
+
+/// <summary>
+/// Times a batch of operations and the allocations they made. Only the time and allocations
+/// inside Time() count, so checks run between operations don't skew the results.
+/// </summary>
+class Measurement
+{
+public:
+
+	/// <summary>
+	/// Starts a measurement that expects up to a number of timed operations.
+	/// </summary>
+	/// <param name="operations">The number of operations that will be timed.</param>
+	explicit Measurement(size_t operations) : allocations_(0)
+	{
+		samples_.reserve(operations);
+	}
+
+	/// <summary>
+	/// Times one operation.
+	/// </summary>
+	/// <param name="operation">The operation to run.</param>
+	template<typename Operation>
+	void Time(Operation&& operation)
+	{
+		const size_t allocations = allocationCount;
+		const Clock::time_point begin = Clock::now();
+		operation();
+		samples_.push_back(std::chrono::duration<double, std::micro>(Clock::now() - begin).count());
+		allocations_ += allocationCount - allocations;
+	}
+
+	/// <summary>
+	/// Prints the throughput, latency percentiles and allocation count of the timed operations.
+	/// </summary>
+	/// <param name="scene">The scene the operations ran on.</param>
+	/// <param name="name">The name of the operation.</param>
+	void Report(const Scene& scene, const char* name)
+	{
+		const double seconds = std::accumulate(samples_.begin(), samples_.end(), 0.0) / 1e6;
+
+		std::sort(samples_.begin(), samples_.end());
+		auto percentile = [&](double p)
+		{
+			return samples_.empty() ? 0.0 : samples_[std::min(samples_.size() - 1, static_cast<size_t>(p * samples_.size()))];
+		};
+
+		std::printf("%-12s %8zu  %-14s %12.0f %10.2f %10.2f %10.2f %10.2f %10zu\n",
+			scene.name, scene.bounds.size(), name, seconds > 0.0 ? samples_.size() / seconds : 0.0,
+			percentile(0.5), percentile(0.9), percentile(0.99), samples_.empty() ? 0.0 : samples_.back(), allocations_);
+	}
+
+private:
+
+	/// <summary>
+	/// How long each operation took in microseconds.
+	/// </summary>
+	std::vector<double> samples_;
+
+	/// <summary>
+	/// The number of allocations made by the timed operations.
+	/// </summary>
+	size_t allocations_;
+};
+
+/*****************************************************************************/
+/*                               CROSS CHECKS                                */
+/*****************************************************************************/
+
+/// <summary>
+/// Compares GetCollisionCandidates against testing every pair, for every object in small
+/// scenes and a random sample of objects in large ones.
+/// </summary>
+/// <param name="tree">The tree to check.</param>
+/// <param name="scene">The scene stored in the tree.</param>
+/// <param name="alive">Which objects are in the tree.</param>
+/// <param name="rng">The random number generator.</param>
+/// <param name="stage">Printed if the check fails.</param>
+/// <returns>The number of objects whose candidates were wrong.</returns>
+static unsigned CrossCheck(const BenchmarkTree& tree, const Scene& scene, const std::vector<bool>& alive, std::mt19937& rng, const char* stage)
+{
+	const unsigned count = static_cast<unsigned>(scene.bounds.size());
+	const unsigned samples = std::min(count, 1000u);
+	std::uniform_int_distribution<unsigned> pick(0, count - 1);
+
+	unsigned failures = 0;
+	std::vector<unsigned> expected, found;
+	for (unsigned sample = 0; sample < samples; ++sample)
+	{
+		const unsigned object = samples == count ? sample : pick(rng);
+		if (!alive[object])
+			continue;
+
+		expected.clear();
+		for (unsigned other = 0; other < count; ++other)
+		{
+			if (other != object && alive[other] && scene.bounds[other].Overlaps(scene.bounds[object]))
+				expected.push_back(other);
+		}
+
+		found.clear();
+		tree.GetCollisionCandidates(object, found);
+		std::sort(found.begin(), found.end());
+
+		if (found != expected)
+			++failures;
+	}
+
+	if (failures)
+		std::printf("MISMATCH %s %u %s: %u objects had the wrong candidates\n", scene.name, count, stage, failures);
+
+	return failures;
+}
+
+/// <summary>
+/// The largest scene whose pairs are checked against brute force, which is O(n^2).
+/// </summary>
+static constexpr unsigned PairCheckLimit = 10000;
+
+/// <summary>
+/// Compares every pair FindAllPairs reports with the pairs found by brute force. Each overlapping
+/// pair of objects in the tree has to be reported exactly once. Skipped for scenes larger than PairCheckLimit.
+/// </summary>
+/// <param name="tree">The tree to check.</param>
+/// <param name="scene">The scene stored in the tree.</param>
+/// <param name="alive">Which objects are in the tree.</param>
+/// <param name="stage">Printed if the check fails.</param>
+/// <returns>1 if the pairs were wrong, 0 otherwise.</returns>
+static unsigned CheckPairs(BenchmarkTree& tree, const Scene& scene, const std::vector<bool>& alive, const char* stage)
+{
+	const unsigned count = static_cast<unsigned>(scene.bounds.size());
+	if (count > PairCheckLimit)
+		return 0;
+
+	std::vector<BenchmarkTree::ObjectPair> expected;
+	for (unsigned a = 0; a < count; ++a)
+	{
+		if (!alive[a])
+			continue;
+
+		for (unsigned b = a + 1; b < count; ++b)
+		{
+			if (alive[b] && scene.bounds[a].Overlaps(scene.bounds[b]))
+				expected.emplace_back(a, b);
+		}
+	}
+
+	std::vector<BenchmarkTree::ObjectPair> found;
+	tree.FindAllPairs(found);
+	for (BenchmarkTree::ObjectPair& pair : found)
+	{
+		if (pair.second < pair.first)
+			std::swap(pair.first, pair.second);
+	}
+	std::sort(found.begin(), found.end());
+
+	if (found == expected)
+		return 0;
+
+	std::printf("MISMATCH %s %u %s: FindAllPairs found %zu pairs, brute force %zu\n", scene.name, count, stage, found.size(), expected.size());
+	return 1;
+}
+
+/// <summary>
+/// Starts a tree much smaller than the scene so it has to grow, then shrinks it back again and
+/// again. Each Resize() and Clear() has to undo the growing, or the growth budget runs out and the
+/// tree stops growing.
+/// </summary>
+/// <param name="scene">The scene to store.</param>
+/// <param name="rng">The random number generator.</param>
+/// <returns>The number of failed checks.</returns>
+static unsigned CheckGrowth(const Scene& scene, std::mt19937& rng)
+{
+	const unsigned count = static_cast<unsigned>(scene.bounds.size());
+	const DirectX::SimpleMath::Vector2 center = scene.world.Center();
+	const float halfSize = (scene.world.Maximum().x - scene.world.Minimum().x) / 128.f;
+	const AABB small(center.x - halfSize, center.y - halfSize, center.x + halfSize, center.y + halfSize);
+
+	BenchmarkTree tree(4, 8, small, SceneBounds{ &scene });
+	const std::vector<bool> alive(count, true);
+	auto holdsScene = [&]
+	{
+		return std::all_of(scene.bounds.begin(), scene.bounds.end(), [&](const AABB& bounds) { return ContainsAABB(tree.GetBounds(), bounds); });
+	};
+
+	unsigned failures = 0;
+	for (unsigned object = 0; object < count; ++object)
+		tree.Insert(object);
+
+	// every round grows by several levels, so together they go well past MaxGrowDepth
+	for (unsigned round = 0; round < 8; ++round)
+	{
+		tree.Resize(small);
+		if (!holdsScene())
+		{
+			std::printf("MISMATCH %s %u: the tree did not grow again after Resize %u\n", scene.name, count, round);
+			++failures;
+		}
+		failures += CrossCheck(tree, scene, alive, rng, "after growing");
+	}
+
+	tree.Clear();
+	const AABB cleared = tree.GetBounds();
+	if (cleared.Minimum().x != small.Minimum().x || cleared.Maximum().x != small.Maximum().x)
+	{
+		std::printf("MISMATCH %s %u: Clear did not go back to the original bounds\n", scene.name, count);
+		++failures;
+	}
+
+	for (unsigned object = 0; object < count; ++object)
+		tree.Insert(object);
+	if (!holdsScene())
+	{
+		std::printf("MISMATCH %s %u: the tree did not grow again after Clear\n", scene.name, count);
+		++failures;
+	}
+	failures += CrossCheck(tree, scene, alive, rng, "after growing again");
+
+	return failures;
+}
+
+/*****************************************************************************/
+/*                                BENCHMARKS                                 */
+/*****************************************************************************/
+
+/// <summary>
+/// Runs every operation on one scene.
+/// </summary>
+/// <param name="scene">The scene to run on. The Update stage moves its objects.</param>
+/// <param name="rng">The random number generator.</param>
+/// <returns>The number of cross check failures.</returns>
+static unsigned RunScene(Scene& scene, std::mt19937& rng)
+{
+	const unsigned count = static_cast<unsigned>(scene.bounds.size());
+
+	// deep enough that the smallest nodes are about the size of an object
+	const unsigned maxDepth = std::clamp(static_cast<unsigned>(std::log2(std::sqrt(static_cast<float>(count)))), 4u, 12u);
+	BenchmarkTree tree(maxDepth, 8, scene.world, SceneBounds{ &scene });
+
+	std::vector<unsigned> objects(count);
+	for (unsigned i = 0; i < count; ++i)
+		objects[i] = i;
+	std::vector<bool> alive(count, true);
+	unsigned failures = 0;
+
+	{
+		Measurement measurement(count);
+		for (unsigned object : objects)
+			measurement.Time([&] { tree.Insert(object); });
+		measurement.Report(scene, "Insert");
+	}
+	failures += CrossCheck(tree, scene, alive, rng, "after Insert");
+
+	{
+		const unsigned queries = std::min(count, 100000u);
+		std::vector<unsigned> candidates;
+		candidates.reserve(256);
+		Measurement measurement(queries);
+		for (unsigned i = 0; i < queries; ++i)
+		{
+			candidates.clear();
+			measurement.Time([&] { tree.GetCollisionCandidates(objects[i], candidates); });
+		}
+		measurement.Report(scene, "Candidates");
+	}
+
+	{
+		constexpr unsigned Frames = 3;
+		std::vector<BenchmarkTree::ObjectPair> pairs;
+		Measurement measurement(Frames);
+		for (unsigned frame = 0; frame < Frames; ++frame)
+		{
+			pairs.clear();
+			measurement.Time([&] { tree.FindAllPairs(pairs); });
+		}
+		measurement.Report(scene, "Pairs");
+	}
+	failures += CheckPairs(tree, scene, alive, "after Insert");
+
+	{
+		// most objects move a little, every tenth jumps far enough to leave its node
+		const float jump = (scene.world.Maximum().x - scene.world.Minimum().x) / 8.f;
+		std::uniform_real_distribution<float> step(-1.f, 1.f);
+		Measurement measurement(count);
+		for (unsigned object : objects)
+		{
+			const float scale = object % 10 == 0 ? jump : 1.f;
+			const DirectX::SimpleMath::Vector2 offset(step(rng) * scale, step(rng) * scale);
+			const AABB& bounds = scene.bounds[object];
+			scene.bounds[object] = AABB(bounds.Minimum().x + offset.x, bounds.Minimum().y + offset.y, bounds.Maximum().x + offset.x, bounds.Maximum().y + offset.y);
+			measurement.Time([&] { tree.Update(object); });
+		}
+		measurement.Report(scene, "Update");
+	}
+	failures += CrossCheck(tree, scene, alive, rng, "after Update");
+	failures += CheckPairs(tree, scene, alive, "after Update");
+
+	{
+		constexpr unsigned Frames = 3;
+		Measurement measurement(Frames);
+		for (unsigned frame = 0; frame < Frames; ++frame)
+		{
+			measurement.Time([&]
+			{
+				tree.Clear();
+				for (unsigned object : objects)
+					tree.Insert(object);
+			});
+		}
+		measurement.Report(scene, "Rebuild");
+	}
+
+	{
+		constexpr unsigned Frames = 3;
+		Measurement measurement(Frames);
+		for (unsigned frame = 0; frame < Frames; ++frame)
+			measurement.Time([&] { tree.BuildFrom(objects); });
+		measurement.Report(scene, "BuildFrom");
+	}
+	failures += CrossCheck(tree, scene, alive, rng, "after BuildFrom");
+	failures += CheckPairs(tree, scene, alive, "after BuildFrom");
+
+	{
+		const AABB& world = scene.world;
+		Measurement measurement(1);
+		measurement.Time([&] { tree.Resize(AABB(world.Minimum().x * 2.f, world.Minimum().y * 2.f, world.Maximum().x * 2.f, world.Maximum().y * 2.f)); });
+		measurement.Report(scene, "Resize");
+	}
+	failures += CrossCheck(tree, scene, alive, rng, "after Resize");
+	failures += CheckPairs(tree, scene, alive, "after Resize");
+
+	{
+		// half the objects are removed in a random order, then checked before the rest go
+		std::vector<unsigned> order = objects;
+		std::shuffle(order.begin(), order.end(), rng);
+
+		Measurement measurement(count);
+		for (unsigned i = 0; i < count / 2; ++i)
+		{
+			measurement.Time([&] { tree.Remove(order[i]); });
+			alive[order[i]] = false;
+		}
+		failures += CrossCheck(tree, scene, alive, rng, "after Remove");
+		failures += CheckPairs(tree, scene, alive, "after Remove");
+
+		for (unsigned i = count / 2; i < count; ++i)
+			measurement.Time([&] { tree.Remove(order[i]); });
+		measurement.Report(scene, "Remove");
+
+		if (tree.GetTotalObjects() != 0)
+		{
+			std::printf("MISMATCH %s %u: %u objects left after removing all of them\n", scene.name, count, tree.GetTotalObjects());
+			++failures;
+		}
+	}
+
+	{
+		tree.BuildFrom(objects);
+		Measurement measurement(1);
+		measurement.Time([&] { tree.Clear(); });
+		measurement.Report(scene, "Clear");
+	}
+
+	return failures;
+}
+
+/*****************************************************************************/
+/*                                   MAIN                                    */
+/*****************************************************************************/
+int main(int argc, char** argv)
+{
+	const unsigned largest = argc > 1 ? static_cast<unsigned>(std::strtoul(argv[1], nullptr, 10)) : 1000000u;
+
+	std::printf("%-12s %8s  %-14s %12s %10s %10s %10s %10s %10s\n",
+		"scene", "objects", "operation", "ops/s", "p50 us", "p90 us", "p99 us", "max us", "allocs");
+
+	std::mt19937 rng(20210);
+	unsigned failures = 0;
+	for (unsigned count = 1000; count <= largest; count *= 10)
+	{
+		for (SceneType type : { SceneType::Uniform, SceneType::Clustered, SceneType::LargeObjects, SceneType::CenterLines })
+		{
+			Scene scene = MakeScene(type, count, rng);
+			failures += RunScene(scene, rng);
+			if (count == 1000)
+				failures += CheckGrowth(scene, rng);
+		}
+	}
+
+	if (failures)
+	{
+		std::printf("%u cross checks failed\n", failures);
+		return EXIT_FAILURE;
+	}
+
+	std::printf("every cross check passed\n");
+	return EXIT_SUCCESS;
+}
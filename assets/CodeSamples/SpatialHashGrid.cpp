@@ -0,0 +1,21 @@
+﻿#pragma once
+#include "stdafx.h"
+/*******************************************************************************
+
+	@file SpatialHashGrid.cpp
+
+	@date 10/17/2026 9:03:51 PM
+
+	@authors
+	Christian Wookey (christian.wookey@digipen.edu)
+
+	@brief
+	Uniform grid broadphase that hashes cells into an open addressed table.
+
+	@copyright All content © copyright 2020-2021, DigiPen (USA) Corporation 
+
+*******************************************************************************/
+
+#include "SpatialHashGrid.h"
+
+template class BasicSpatialHashGrid<GameObject*, GameObjectBounds>;
@@ -0,0 +1,27 @@
+﻿#pragma once
+/*******************************************************************************
+
+	@file SpatialHashGrid.h
+
+	@date 10/17/2026 9:03:51 PM
+
+	@authors
+	Christian Wookey (christian.wookey@digipen.edu)
+
+	@brief
+	Uniform grid broadphase that hashes cells into an open addressed table.
+
+	@copyright All content © copyright 2020-2021, DigiPen (USA) Corporation 
+
+*******************************************************************************/
+
+#include "BasicSpatialHashGrid.h"
+#include "GameObjectBounds.h"
+
+/// <summary>
+/// The spatial hash grid used by the engine, which stores GameObject pointers.
+/// </summary>
+using SpatialHashGrid = BasicSpatialHashGrid<GameObject*, GameObjectBounds>;
+
+// compiled once in SpatialHashGrid.cpp
+extern template class BasicSpatialHashGrid<GameObject*, GameObjectBounds>;
@@ -0,0 +1,21 @@
+﻿#pragma once
+#include "stdafx.h"
+/*******************************************************************************
+
+	@file SplitQuadtree.cpp
+
+	@date 10/17/2026 5:03:19 PM
+
+	@authors
+	Christian Wookey (christian.wookey@digipen.edu)
+
+	@brief
+	Broadphase that keeps static and dynamic objects in separate trees.
+
+	@copyright All content © copyright 2020-2021, DigiPen (USA) Corporation 
+
+*******************************************************************************/
+
+#include "SplitQuadtree.h"
+
+template class BasicSplitQuadtree<GameObject*, GameObjectBounds>;
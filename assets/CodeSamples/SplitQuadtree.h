@@ -0,0 +1,27 @@
+﻿#pragma once
+/*******************************************************************************
+
+	@file SplitQuadtree.h
+
+	@date 10/17/2026 5:03:19 PM
+
+	@authors
+	Christian Wookey (christian.wookey@digipen.edu)
+
+	@brief
+	Broadphase that keeps static and dynamic objects in separate trees.
+
+	@copyright All content © copyright 2020-2021, DigiPen (USA) Corporation 
+
+*******************************************************************************/
+
+#include "BasicSplitQuadtree.h"
+#include "GameObjectBounds.h"
+
+/// <summary>
+/// The split broadphase used by the engine, which stores GameObject pointers.
+/// </summary>
+using SplitQuadtree = BasicSplitQuadtree<GameObject*, GameObjectBounds>;
+
+// compiled once in SplitQuadtree.cpp
+extern template class BasicSplitQuadtree<GameObject*, GameObjectBounds>;